@@ -0,0 +1,81 @@
+#include "anytime.h"
+
+//no std::thread in single threaded wasm builds, inner strategy runs inline there
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+static const bool USE_WORKER = false;
+#else
+static const bool USE_WORKER = true;
+#endif
+
+AnytimeStrategy::AnytimeStrategy(std::unique_ptr<GuessStrategy> inner)
+    : inner_(std::move(inner))
+{
+    if (USE_WORKER && inner_){
+        worker_ = std::thread(&AnytimeStrategy::run, this);
+    }
+}
+
+AnytimeStrategy::~AnytimeStrategy() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()){
+        worker_.join();
+    }
+}
+
+void AnytimeStrategy::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return stop_ || hasJob_; });
+        if (stop_){
+            return;
+        }
+        GuessState job = job_;
+        uint64_t id = jobId_;
+        hasJob_ = false;
+        busy_ = true;
+        lock.unlock();
+        char c = inner_->pick(job);
+        lock.lock();
+        busy_ = false;
+        result_ = c;
+        doneId_ = id;
+        cv_.notify_all();
+    }
+}
+
+char AnytimeStrategy::pick(const GuessState& state) {
+    if (!inner_){
+        return 0;
+    }
+    using Clock = std::chrono::steady_clock;
+    GuessState job = state;
+    if (state.deadline != Clock::time_point::max()) { //leave 10% of the turn for handing the answer back
+        Clock::time_point now = Clock::now();
+        if (state.deadline > now){
+            job.deadline = now + (state.deadline - now) * 9 / 10;
+        }
+    }
+    if (!worker_.joinable()){
+        return inner_->pick(job);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (busy_ || hasJob_){
+        return 0; //last turn's search is still running past its deadline
+    }
+    job_ = job;
+    hasJob_ = true;
+    uint64_t id = ++jobId_;
+    cv_.notify_all();
+    auto finished = [&] { return doneId_ == id; };
+    if (state.deadline == Clock::time_point::max()) { //no deadline: wait_until(max) overflows on some libstdc++/MinGW
+        cv_.wait(lock, finished);
+        return result_;
+    }
+    bool done = cv_.wait_until(lock, state.deadline, finished);
+    return done ? result_ : 0;
+}
@@ -0,0 +1,36 @@
+#ifndef ANYTIME_H
+#define ANYTIME_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "solver.h"
+
+//runs a strategy on a worker thread and never waits past GuessState::deadline
+//the inner strategy gets a slightly earlier deadline to hand back its best letter so far,
+//if it still is not done the turn answers 0 (engine uses LetterQueue order)
+class AnytimeStrategy final : public GuessStrategy {
+public:
+    explicit AnytimeStrategy(std::unique_ptr<GuessStrategy> inner);
+    ~AnytimeStrategy() override;
+
+    char pick(const GuessState& state) override;
+
+private:
+    void run(); //worker loop
+
+    std::unique_ptr<GuessStrategy> inner_;
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    GuessState job_;
+    bool hasJob_ = false;
+    bool busy_ = false;   //worker still on a job (maybe one that already timed out)
+    bool stop_ = false;
+    uint64_t jobId_ = 0;
+    uint64_t doneId_ = 0;
+    char result_ = 0;
+};
+
+#endif // ANYTIME_H
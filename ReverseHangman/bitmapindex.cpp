@@ -0,0 +1,119 @@
+#include "bitmapindex.h"
+
+void BitmapIndex::build(const Dictionary& dict) {
+    byLength_.assign(33, Length());
+    for (size_t len = 1; len <= 32; ++len) {
+        const std::vector<std::string>& words = dict.wordsOfLength(len);
+        Length& L = byLength_[len];
+        L.words = words.size();
+        L.stride = (words.size() + 63) / 64;
+        if (!L.words){
+            continue;
+        }
+        L.bits.assign((len + 1) * 26 * L.stride, 0);
+        for (size_t i = 0; i < words.size(); ++i) {
+            uint64_t bit = 1ull << (i & 63);
+            size_t word = i / 64;
+            for (size_t pos = 0; pos < len; ++pos) {
+                int c = words[i][pos] - 'A';
+                L.bits[(pos * 26 + c) * L.stride + word] |= bit;
+                L.bits[(len * 26 + c) * L.stride + word] |= bit;
+            }
+        }
+    }
+}
+
+size_t BitmapIndex::candidates(const std::string& pattern, uint32_t guessed, std::vector<uint64_t>& out) const {
+    size_t len = pattern.size();
+    out.clear();
+    if (len == 0 || len >= byLength_.size() || byLength_[len].words == 0){
+        return 0;
+    }
+    const Length& L = byLength_[len];
+    out.assign(L.stride, ~0ull);
+    if (L.words % 64){
+        out.back() = (1ull << (L.words % 64)) - 1; //no bits past the last word
+    }
+
+    uint32_t shown = 0; //letters revealed somewhere in the pattern
+    for (size_t pos = 0; pos < len; ++pos) {
+        if (pattern[pos] == '_'){
+            continue;
+        }
+        int c = pattern[pos] - 'A';
+        shown |= 1u << c;
+        const uint64_t* m = L.map(pos, c);
+        for (size_t w = 0; w < L.stride; ++w){
+            out[w] &= m[w];
+        }
+    }
+    for (uint32_t g = guessed; g; g &= g - 1) {
+        int c = __builtin_ctz(g);
+        if (!(shown & (1u << c))) { //a miss: nowhere in the word
+            const uint64_t* m = L.map(len, c);
+            for (size_t w = 0; w < L.stride; ++w){
+                out[w] &= ~m[w];
+            }
+            continue;
+        }
+        for (size_t pos = 0; pos < len; ++pos) { //revealed letter: not at the hidden spots
+            if (pattern[pos] != '_'){
+                continue;
+            }
+            const uint64_t* m = L.map(pos, c);
+            for (size_t w = 0; w < L.stride; ++w){
+                out[w] &= ~m[w];
+            }
+        }
+    }
+
+    size_t n = 0;
+    for (uint64_t w : out){
+        n += __builtin_popcountll(w);
+    }
+    return n;
+}
+
+void BitmapIndex::countLetters(const std::string& pattern, uint32_t guessed, CandidateStats& stats) const {
+    std::vector<uint64_t> cand;
+    candidates(pattern, guessed, cand);
+    countLetters(cand, pattern.size(), guessed, stats);
+}
+
+void BitmapIndex::countLetters(const std::vector<uint64_t>& cand, size_t len, uint32_t guessed,
+                               CandidateStats& stats) const {
+    stats = CandidateStats();
+    if (len >= byLength_.size()){
+        return;
+    }
+    const Length& L = byLength_[len];
+    std::vector<uint32_t> live; //words of the bitmap with a candidate, mid-game most are 0
+    for (size_t w = 0; w < L.stride && w < cand.size(); ++w) {
+        if (cand[w]) {
+            live.push_back((uint32_t)w);
+            stats.total += __builtin_popcountll(cand[w]);
+        }
+    }
+    if (!stats.total){
+        return;
+    }
+    for (int c = 0; c < 26; ++c) {
+        if (guessed & (1u << c)){
+            continue;
+        }
+        const uint64_t* m = L.map(len, c);
+        size_t n = 0;
+        for (uint32_t w : live){
+            n += __builtin_popcountll(cand[w] & m[w]);
+        }
+        stats.contains[c] = n;
+    }
+}
+
+size_t BitmapIndex::memoryBytes() const {
+    size_t n = 0;
+    for (const Length& L : byLength_){
+        n += L.bits.size() * sizeof(uint64_t);
+    }
+    return n;
+}
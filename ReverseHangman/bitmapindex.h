@@ -0,0 +1,46 @@
+#ifndef BITMAPINDEX_H
+#define BITMAPINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "solver.h"
+#include "solvercache.h"
+
+//inverted index over the dictionary: per word length, one bitmap per (position, letter)
+//plus one "contains" bitmap per letter, bit i = wordsOfLength(len)[i]
+//a masked word's candidates are a few AND/ANDNOTs, letter counts are popcounts
+class BitmapIndex {
+public:
+    void build(const Dictionary& dict); //keep dict alive and unchanged, bits refer to its lists
+
+    //candidate bitmap of a masked word (same rule as matchesPattern), returns how many
+    size_t candidates(const std::string& pattern, uint32_t guessed, std::vector<uint64_t>& out) const;
+    //total + candidates containing each unguessed letter, no word is read
+    void countLetters(const std::string& pattern, uint32_t guessed, CandidateStats& stats) const;
+    //same, from a bitmap candidates() already gave for a word of len letters
+    void countLetters(const std::vector<uint64_t>& cand, size_t len, uint32_t guessed, CandidateStats& stats) const;
+
+    size_t memoryBytes() const;
+
+    //calls fn(i) for every set bit, in order
+    template <typename Fn>
+    static void forEachBit(const std::vector<uint64_t>& bits, Fn fn) {
+        for (size_t w = 0; w < bits.size(); ++w) {
+            for (uint64_t b = bits[w]; b; b &= b - 1){
+                fn(w * 64 + __builtin_ctzll(b));
+            }
+        }
+    }
+
+private:
+    struct Length {
+        size_t words = 0;  //dictionary words of this length
+        size_t stride = 0; //uint64 per bitmap
+        std::vector<uint64_t> bits; //(len + 1) * 26 bitmaps, row len = contains
+        const uint64_t* map(size_t pos, int letter) const { return bits.data() + (pos * 26 + letter) * stride; }
+    };
+    std::vector<Length> byLength_;
+};
+
+#endif // BITMAPINDEX_H
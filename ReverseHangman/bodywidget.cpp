@@ -3,12 +3,17 @@
 #include <QMouseEvent>
 #include <QResizeEvent>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <array>
 
 // size of original PNG
 static const int BODY_IMG_WIDTH  = 1280;
 static const int BODY_IMG_HEIGHT = 720;
 
+static const int BLOOD_SPILL = 5; //blood rect grows this much past the limb so it "spills over"
+static const qreal BLOOD_OPACITY = 0.85; //slight transparency
+static const int PAINT_STATS_EVERY = 50; //paints per logged average
+
 //rectangle bases for each limb
 static const std::array<QRect, BodyWidget::LIMB_COUNT> BASE_RECTS = {
     QRect(457,  32,  83,  99),  // 0 Head
@@ -40,38 +45,102 @@ BodyWidget::BodyWidget(QWidget *parent)
     lost_.fill(false);
     selectable_.fill(false);
     setMinimumSize(400, 225); // minimum aspect
-    updateHitRects();
+    paintStats_ = qEnvironmentVariableIsSet("RH_PAINT_STATS");
+    updateHitRects(); //sprites are scaled on the first resizeEvent, before any paint
 }
 
 void BodyWidget::setLostLimbs(const std::vector<bool>& lost)
 {
     for (int i = 0; i < LIMB_COUNT; ++i) {  //copy lost flags into array (fixed)
-        if (i < (int)lost.size()){
-            lost_[i] = lost[i];
-        }
-        else{
-            lost_[i] = false;
+        bool now = i < (int)lost.size() && lost[i];
+        if (lost_[i] != now) {
+            lost_[i] = now;
+            updateLimb(i);
         }
     }
-    update();
 }
 
 void BodyWidget::setSelectableLimbs(const std::vector<int>& indices)
 {
-    selectable_.fill(false);
+    std::array<bool, LIMB_COUNT> now;
+    now.fill(false);
     for (int idx : indices) {
         if (idx >= 0 && idx < LIMB_COUNT){
-            selectable_[idx] = true;
+            now[idx] = true;
+        }
+    }
+    for (int i = 0; i < LIMB_COUNT; ++i) {
+        if (selectable_[i] != now[i]) {
+            selectable_[i] = now[i];
+            updateLimb(i);
         }
     }
-    update();
 }
 
-//for resizing, recomputes hitRects_
+//repaint only what limb i can touch: blood spills BLOOD_SPILL past the hitbox, the outline stays inside it
+void BodyWidget::updateLimb(int index)
+{
+    update(hitRects_[index].adjusted(-BLOOD_SPILL, -BLOOD_SPILL, BLOOD_SPILL, BLOOD_SPILL));
+}
+
+//for resizing, recomputes hitRects_ and the scaled sprites
 void BodyWidget::resizeEvent(QResizeEvent *event)
 {
     QWidget::resizeEvent(event);
+    frames_.clear(); //one size cached at a time, a resize drag doesn't pile up frames
     updateHitRects();
+    rescalePixmaps();
+}
+
+//moved to a screen with another device pixel ratio: the size may be the same, the sprites are not
+bool BodyWidget::event(QEvent *event)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+    const QEvent::Type scaleChange = QEvent::DevicePixelRatioChange;
+#else
+    const QEvent::Type scaleChange = QEvent::ScreenChangeInternal; //older qt: any screen change
+#endif
+    if (event->type() == scaleChange) {
+        frames_.clear();
+        rescalePixmaps();
+        update();
+    }
+    return QWidget::event(event);
+}
+
+//smooth scaling once per size instead of on every repaint
+void BodyWidget::rescalePixmaps()
+{
+    QElapsedTimer timer;
+    timer.start();
+    qreal dpr = devicePixelRatioF(); //scale to device pixels so the blit is 1:1 on hi-dpi screens
+
+    scaledBody_ = QPixmap();
+    if (!bodyImage_.isNull() && !size().isEmpty()) {
+        scaledBody_ = bodyImage_.scaled(size() * dpr, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        scaledBody_.setDevicePixelRatio(dpr);
+    }
+
+    for (int i = 0; i < LIMB_COUNT; ++i) {
+        scaledBlood_[i] = QPixmap();
+        if (bloodOverlay_.isNull() || !hitRects_[i].isValid()){
+            continue;
+        }
+        QRect bleedRect = hitRects_[i].adjusted(-BLOOD_SPILL, -BLOOD_SPILL, BLOOD_SPILL, BLOOD_SPILL);
+        QPixmap blood(bleedRect.size() * dpr);
+        blood.setDevicePixelRatio(dpr);
+        blood.fill(Qt::transparent);
+        QPainter bp(&blood);
+        bp.setRenderHint(QPainter::SmoothPixmapTransform, true);
+        bp.setOpacity(BLOOD_OPACITY);
+        bp.drawPixmap(QRect(QPoint(0, 0), bleedRect.size()), bloodOverlay_);
+        bp.end();
+        scaledBlood_[i] = blood;
+    }
+
+    if (paintStats_) {
+        qDebug() << "BodyWidget: rescaled to" << size() << "in" << timer.nsecsElapsed() / 1000 << "us";
+    }
 }
 
 //convert base rectangles into hiboxes, preserves aspect ratio
@@ -93,42 +162,88 @@ void BodyWidget::updateHitRects()
     }
 }
 
-void BodyWidget::paintEvent(QPaintEvent *event)
+uint16_t BodyWidget::lostMask() const
 {
-    Q_UNUSED(event);
-    QPainter p(this);
-    p.setRenderHint(QPainter::Antialiasing, true);
-    p.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    uint16_t mask = 0;
+    for (int i = 0; i < LIMB_COUNT; ++i) {
+        if (lost_[i]){
+            mask |= uint16_t(1u << i);
+        }
+    }
+    return mask;
+}
+
+//frames are dropped on resize and screen scale changes, so only the mask picks one
+const QPixmap& BodyWidget::frame()
+{
+    uint16_t mask = lostMask();
+    qreal dpr = devicePixelRatioF();
+    for (auto it = frames_.begin(); it != frames_.end(); ++it) {
+        if (it->lost == mask && it->pixmap.devicePixelRatio() == dpr) { //same screen scale too
+            frames_.splice(frames_.begin(), frames_, it); //move to front
+            return frames_.front().pixmap;
+        }
+    }
+
+    QPixmap pm(size() * dpr);
+    pm.setDevicePixelRatio(dpr);
+    QPainter p(&pm);
 
     // fill background
     p.fillRect(rect(), Qt::black);
 
-    // draw sprite
-    if (!bodyImage_.isNull()) {
-        p.drawPixmap(rect(), bodyImage_);
+    // draw sprite, already at widget size
+    if (!scaledBody_.isNull()) {
+        p.drawPixmap(0, 0, scaledBody_);
     }
 
-    // draw overlay depending on state
+    // draw splatter over lost limbs, scaled and faded in rescalePixmaps()
     for (int i = 0; i < LIMB_COUNT; ++i) {
-        const QRect &r = hitRects_[i];
-        if (!r.isValid()){
-            continue;
+        if (lost_[i] && hitRects_[i].isValid() && !scaledBlood_[i].isNull()) {
+            p.drawPixmap(hitRects_[i].topLeft() - QPoint(BLOOD_SPILL, BLOOD_SPILL), scaledBlood_[i]);
         }
+    }
+    p.end();
+
+    frames_.push_front({mask, pm});
+    //evict the least recent beyond the count or byte budget, the frame just made always stays
+    qint64 frameBytes = qint64(pm.width()) * pm.height() * 4; //32 bpp, every cached frame is this size
+    while (frames_.size() > 1
+           && (frames_.size() > FRAME_CACHE_SIZE || qint64(frames_.size()) * frameBytes > FRAME_CACHE_BYTES)){
+        frames_.pop_back();
+    }
+    return frames_.front().pixmap;
+}
+
+void BodyWidget::paintEvent(QPaintEvent *event)
+{
+    QElapsedTimer timer;
+    timer.start();
+    QPainter p(this);
+
+    // body and blood, blitted only inside the dirty region
+    const QPixmap& pm = frame();
+    qreal dpr = pm.devicePixelRatio();
+    for (const QRect& r : event->region()) {
+        p.drawPixmap(QPointF(r.topLeft()), pm, QRectF(QPointF(r.topLeft()) * dpr, QSizeF(r.size()) * dpr));
+    }
+
+    // selectable limbs outlined on top
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.setPen(QPen(QColor(0, 200, 255), 3)); //selectable == blue outline
+    p.setBrush(Qt::NoBrush);
+    for (int i = 0; i < LIMB_COUNT; ++i) {
+        if (selectable_[i] && !lost_[i] && hitRects_[i].isValid() && event->region().intersects(hitRects_[i])) {
+            p.drawRect(hitRects_[i].adjusted(1, 1, -1, -1));
+        }
+    }
 
-        if (lost_[i]) {
-            // draw splatter over lost limbs
-            if (!bloodOverlay_.isNull()) {
-                QRect bleedRect = r.adjusted(-5, -5, 5, 5); //slghty bigger rectangle so blood "spills over"
-
-                p.save();
-                p.setOpacity(0.85);  // slight transparency
-                p.drawPixmap(bleedRect, bloodOverlay_);
-                p.restore();
-            }
-        } else if (selectable_[i]) {
-            p.setPen(QPen(QColor(0, 200, 255), 3)); //selectable == blue outline
-            p.setBrush(Qt::NoBrush);
-            p.drawRect(r.adjusted(1, 1, -1, -1));
+    if (paintStats_) {
+        paintNs_ += timer.nsecsElapsed();
+        if (++paintCount_ == PAINT_STATS_EVERY) {
+            qDebug() << "BodyWidget: paint" << paintNs_ / paintCount_ / 1000 << "us avg over" << paintCount_;
+            paintNs_ = 0;
+            paintCount_ = 0;
         }
     }
 }
@@ -5,9 +5,13 @@
 #include <QPixmap>
 #include <QRect>
 #include <array>
+#include <cstdint>
+#include <list>
 #include <vector>
 
 //draws sprite, creates hitboxes, creates blood overlays
+//set RH_PAINT_STATS in the environment to log the average paint and rescale times (qDebug), for
+//comparing paint changes; off by default, costs one flag check per paint
 class BodyWidget : public QWidget {
     Q_OBJECT
 public:
@@ -23,15 +27,34 @@ protected:
     void paintEvent(QPaintEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
+    bool event(QEvent *event) override; //screen scale changes rescale like a resize
 
 public:
     static const int LIMB_COUNT = 12;
 
 private:
     void updateHitRects(); // computes hitRects_ according to widget size
+    void rescalePixmaps(); // sprites scaled to the current size, paintEvent only blits these
+    void updateLimb(int index); // schedules a repaint of limb index's area only
+    uint16_t lostMask() const; // bit i = limb i lost
+    const QPixmap& frame(); // body + blood for the current size and lost limbs, from frames_ or composited once
 
     QPixmap bodyImage_; //sprite for body
     QPixmap bloodOverlay_; //blood splatter sprite
+    QPixmap scaledBody_; //bodyImage_ at widget size
+    std::array<QPixmap, LIMB_COUNT> scaledBlood_; //bloodOverlay_ at each limb's spill rect, opacity baked in
+
+    struct Frame {
+        uint16_t lost; //lostMask() it was composited for
+        QPixmap pixmap;
+    };
+    static const size_t FRAME_CACHE_SIZE = 8; //a game visits ~12 masks, only recent ones are redrawn
+    static const qint64 FRAME_CACHE_BYTES = qint64(64) << 20; //full-window frames at 4K are ~33 MB each
+    std::list<Frame> frames_; //LRU, front = most recently used, all at the current size
+
+    bool paintStats_ = false; //RH_PAINT_STATS set: log average paint time (see class comment)
+    qint64 paintNs_ = 0;
+    int paintCount_ = 0;
 
     //limb statuses
     std::array<bool, LIMB_COUNT> lost_; //limb gone == true
@@ -0,0 +1,262 @@
+#include "dawg.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <unordered_map>
+
+static const char DAWG_MAGIC[4] = {'R', 'H', 'D', 'G'};
+
+//node while building, before flattening
+struct BuildNode {
+    bool final = false;
+    std::vector<std::pair<char, uint32_t>> edges; //sorted, words arrive in order
+};
+
+//final flag + outgoing edges, equal signatures = equivalent nodes
+static std::string signature(const BuildNode& n) {
+    std::string sig(1, n.final ? '1' : '0');
+    for (const auto& e : n.edges) {
+        sig.push_back(e.first);
+        sig.append(reinterpret_cast<const char*>(&e.second), sizeof(e.second));
+    }
+    return sig;
+}
+
+void Dawg::build(const Dictionary& dict) {
+    std::vector<std::string> words;
+    for (size_t len = 1; len <= 32; ++len){
+        const auto& list = dict.wordsOfLength(len);
+        words.insert(words.end(), list.begin(), list.end());
+    }
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    std::vector<BuildNode> nodes(1); //0 = root
+    std::unordered_map<std::string, uint32_t> registry;
+    struct Pending { uint32_t parent; char letter; uint32_t child; };
+    std::vector<Pending> unchecked; //path of the previous word not yet minimized
+
+    auto minimize = [&](size_t downTo) {
+        while (unchecked.size() > downTo) {
+            Pending p = unchecked.back();
+            unchecked.pop_back();
+            std::string sig = signature(nodes[p.child]);
+            auto it = registry.find(sig);
+            if (it != registry.end()){
+                nodes[p.parent].edges.back().second = it->second; //reuse the equivalent node
+            }
+            else{
+                registry.emplace(sig, p.child);
+            }
+        }
+    };
+
+    std::string prev;
+    for (const std::string& w : words) {
+        size_t common = 0;
+        while (common < w.size() && common < prev.size() && w[common] == prev[common]){
+            ++common;
+        }
+        minimize(common);
+        uint32_t node = unchecked.empty() ? 0 : unchecked.back().child;
+        for (size_t i = common; i < w.size(); ++i) {
+            uint32_t child = (uint32_t)nodes.size();
+            nodes.emplace_back();
+            nodes[node].edges.push_back({w[i], child});
+            unchecked.push_back({node, w[i], child});
+            node = child;
+        }
+        nodes[node].final = true;
+        prev = w;
+    }
+    minimize(0);
+
+    //flatten the nodes reachable from the root
+    std::vector<uint32_t> id(nodes.size(), UINT32_MAX);
+    std::vector<uint32_t> order{0};
+    id[0] = 0;
+    for (size_t k = 0; k < order.size(); ++k) {
+        for (const auto& e : nodes[order[k]].edges) {
+            if (id[e.second] == UINT32_MAX) {
+                id[e.second] = (uint32_t)order.size();
+                order.push_back(e.second);
+            }
+        }
+    }
+    ownFirst_.assign(1, 0);
+    ownEdges_.clear();
+    ownFinal_.assign(order.size(), 0);
+    for (size_t k = 0; k < order.size(); ++k) {
+        const BuildNode& n = nodes[order[k]];
+        ownFinal_[k] = n.final;
+        for (const auto& e : n.edges){
+            ownEdges_.push_back((id[e.second] << 5) | uint32_t(e.first - 'A'));
+        }
+        ownFirst_.push_back((uint32_t)ownEdges_.size());
+    }
+    adoptOwned();
+}
+
+void Dawg::adoptOwned() {
+    file_.close();
+    nodes_ = (uint32_t)ownFinal_.size();
+    edgeCount_ = (uint32_t)ownEdges_.size();
+    firstEdge_ = ownFirst_.data();
+    edges_ = ownEdges_.data();
+    final_ = ownFinal_.data();
+}
+
+void Dawg::walk(uint32_t node, size_t depth, uint32_t letters, const std::string& pattern,
+                uint32_t guessed, CandidateStats& stats) const {
+    if (depth == pattern.size()) {
+        if (final_[node]) {
+            ++stats.total;
+            for (uint32_t m = letters & ~guessed; m; m &= m - 1){
+                ++stats.contains[__builtin_ctz(m)];
+            }
+        }
+        return;
+    }
+    char p = pattern[depth];
+    for (uint32_t e = firstEdge_[node]; e < firstEdge_[node + 1]; ++e) {
+        uint32_t letter = edges_[e] & 31;
+        if (p == '_' ? (guessed & (1u << letter)) != 0 : letter != uint32_t(p - 'A')){
+            continue; //pruned: revealed letter differs, or hidden spot holding a guessed letter
+        }
+        walk(edges_[e] >> 5, depth + 1, letters | (1u << letter), pattern, guessed, stats);
+    }
+}
+
+void Dawg::countLetters(const std::string& pattern, uint32_t guessed, CandidateStats& stats) const {
+    stats = CandidateStats();
+    if (nodes_ && !pattern.empty()){
+        walk(0, 0, 0, pattern, guessed, stats);
+    }
+}
+
+bool Dawg::contains(const std::string& word) const {
+    if (!nodes_){
+        return false;
+    }
+    uint32_t node = 0;
+    for (char c : word) {
+        uint32_t next = UINT32_MAX;
+        if (c < 'A' || c > 'Z'){
+            return false;
+        }
+        for (uint32_t e = firstEdge_[node]; e < firstEdge_[node + 1]; ++e) {
+            if ((edges_[e] & 31) == uint32_t(c - 'A')) {
+                next = edges_[e] >> 5;
+                break;
+            }
+        }
+        if (next == UINT32_MAX){
+            return false;
+        }
+        node = next;
+    }
+    return final_[node];
+}
+
+size_t Dawg::memoryBytes() const {
+    return ownFirst_.size() * sizeof(uint32_t) + ownEdges_.size() * sizeof(uint32_t) + ownFinal_.size();
+}
+
+//file: magic, node count, edge count, first edges, edges, final flags (one byte per node)
+bool Dawg::attach(const char* data, size_t size) {
+    uint32_t counts[2]; //nodes, edges
+    if (size < 12 || std::memcmp(data, DAWG_MAGIC, 4) != 0){
+        return false;
+    }
+    std::memcpy(counts, data + 4, sizeof(counts));
+    uint64_t need = 12 + (uint64_t(counts[0]) + 1) * 4 + uint64_t(counts[1]) * 4 + counts[0];
+    if (counts[0] == 0 || need > size){
+        return false;
+    }
+    const uint32_t* first = reinterpret_cast<const uint32_t*>(data + 12);
+    const uint32_t* edges = first + counts[0] + 1;
+    for (size_t n = 0; n < counts[0]; ++n) { //reject files that would walk out of bounds
+        if (first[n] > first[n + 1] || first[n + 1] > counts[1]){
+            return false;
+        }
+    }
+    for (size_t e = 0; e < counts[1]; ++e) {
+        if ((edges[e] >> 5) >= counts[0] || (edges[e] & 31) >= 26){
+            return false;
+        }
+    }
+    nodes_ = counts[0];
+    edgeCount_ = counts[1];
+    firstEdge_ = first;
+    edges_ = edges;
+    final_ = reinterpret_cast<const uint8_t*>(edges + counts[1]);
+    return true;
+}
+
+bool Dawg::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> image((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::vector<uint32_t> words((image.size() + 3) / 4); //aligned copy of the file
+    if (!image.empty()){
+        std::memcpy(words.data(), image.data(), image.size());
+    }
+    if (!attach(reinterpret_cast<const char*>(words.data()), image.size())){
+        nodes_ = 0;
+        return false;
+    }
+    ownFirst_.assign(firstEdge_, firstEdge_ + nodes_ + 1);
+    ownEdges_.assign(edges_, edges_ + edgeCount_);
+    ownFinal_.assign(final_, final_ + nodes_);
+    adoptOwned();
+    return true;
+}
+
+bool Dawg::map(const std::string& path) {
+    nodes_ = 0;
+    if (!file_.open(path) || !attach(file_.data(), file_.size())){ //mmap is page aligned
+        file_.close();
+        return false;
+    }
+    ownFirst_.clear();
+    ownEdges_.clear();
+    ownFinal_.clear();
+    return true;
+}
+
+bool Dawg::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    uint32_t counts[2] = {nodes_, edgeCount_};
+    out.write(DAWG_MAGIC, 4);
+    out.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+    out.write(reinterpret_cast<const char*>(firstEdge_), (nodes_ ? nodes_ + 1 : 0) * sizeof(uint32_t));
+    out.write(reinterpret_cast<const char*>(edges_), edgeCount_ * sizeof(uint32_t));
+    out.write(reinterpret_cast<const char*>(final_), nodes_);
+    return bool(out);
+}
+
+DawgStrategy::DawgStrategy(std::shared_ptr<const Dawg> dawg)
+    : dawg_(std::move(dawg))
+{
+}
+
+char DawgStrategy::pick(const GuessState& state) {
+    if (!dawg_){
+        return 0;
+    }
+    for (const std::string& pattern : unsolvedWords(state.masked)) {
+        CandidateStats stats;
+        dawg_->countLetters(pattern, state.guessed, stats);
+        int best = -1;
+        for (int c = 0; c < 26; ++c) {
+            if (stats.contains[c] && (best < 0 || stats.contains[c] > stats.contains[best])){
+                best = c;
+            }
+        }
+        if (best >= 0){
+            return char('A' + best);
+        }
+    }
+    return 0;
+}
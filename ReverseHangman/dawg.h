@@ -0,0 +1,62 @@
+#ifndef DAWG_H
+#define DAWG_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "mappedfile.h"
+#include "solver.h"
+#include "solvercache.h"
+
+//minimized directed acyclic word graph of the word list (shared prefixes and suffixes)
+//edge = (target node << 5) | letter, edges of a node are contiguous and sorted by letter
+//the arrays are either owned (build/load) or a view into a mapped words.dawg (map)
+class Dawg {
+public:
+    Dawg() = default;
+    Dawg(const Dawg&) = delete;
+    Dawg& operator=(const Dawg&) = delete;
+
+    void build(const Dictionary& dict); //incremental minimization over the sorted word list
+    bool load(const std::string& path); //read into memory
+    bool map(const std::string& path);  //use the file in place, pages shared with other processes
+    bool save(const std::string& path) const;
+
+    //candidates of one masked word ("_" = hidden, hidden spots can't be a guessed letter),
+    //counted per letter during a pruned walk, no word is ever materialized
+    void countLetters(const std::string& pattern, uint32_t guessed, CandidateStats& stats) const;
+
+    bool contains(const std::string& word) const;
+    size_t nodeCount() const { return nodes_; }
+    size_t edgeCount() const { return edgeCount_; }
+    size_t memoryBytes() const; //heap bytes, 0 when mapped
+
+private:
+    void walk(uint32_t node, size_t depth, uint32_t letters, const std::string& pattern,
+              uint32_t guessed, CandidateStats& stats) const;
+    bool attach(const char* data, size_t size); //validate a file image and point the views at it
+    void adoptOwned();
+
+    uint32_t nodes_ = 0;
+    uint32_t edgeCount_ = 0;
+    const uint32_t* firstEdge_ = nullptr; //nodes_ + 1 entries, node n owns [firstEdge_[n], firstEdge_[n+1])
+    const uint32_t* edges_ = nullptr;
+    const uint8_t* final_ = nullptr;      //1 = a word ends at this node
+
+    std::vector<uint32_t> ownFirst_, ownEdges_;
+    std::vector<uint8_t> ownFinal_;
+    MappedFile file_;
+};
+
+//most-candidates letter from a Dawg, the memory-lean solver (wasm, many sessions)
+class DawgStrategy final : public GuessStrategy {
+public:
+    explicit DawgStrategy(std::shared_ptr<const Dawg> dawg);
+    char pick(const GuessState& state) override;
+
+private:
+    std::shared_ptr<const Dawg> dawg_;
+};
+
+#endif // DAWG_H
@@ -0,0 +1,238 @@
+#include "decisiontree.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+static const char TREE_MAGIC[4] = {'R', 'H', 'D', 'T'};
+
+using WordGroups = std::map<uint32_t, std::vector<const std::string*>>;
+
+static uint32_t positionsOf(const char* w, size_t len, char c) {
+    uint32_t m = 0;
+    for (size_t i = 0; i < len; ++i) {
+        if (w[i] == c){
+            m |= 1u << i;
+        }
+    }
+    return m;
+}
+
+//split words by where letter c shows up in them
+static WordGroups splitBy(const std::vector<const std::string*>& words, size_t len, char c) {
+    WordGroups groups;
+    for (const std::string* w : words){
+        groups[positionsOf(w->data(), len, c)].push_back(w);
+    }
+    return groups;
+}
+
+//lowest expected misses from here, exhaustive so only used on tiny sets
+static double exactCost(const std::vector<const std::string*>& words, uint32_t guessed,
+                        size_t len, char* bestLetter) {
+    if (words.size() <= 1){
+        return 0.0; //known word, rest of its letters are free hits
+    }
+    double best = 1e9;
+    for (int i = 0; i < 26; ++i) {
+        if (guessed & (1u << i)){
+            continue;
+        }
+        WordGroups groups = splitBy(words, len, char('A' + i));
+        if (groups.size() < 2){
+            continue; //tells us nothing (all miss or same spot everywhere)
+        }
+        double cost = 0.0;
+        for (const auto& g : groups) {
+            double p = double(g.second.size()) / double(words.size());
+            cost += p * ((g.first == 0 ? 1.0 : 0.0) + exactCost(g.second, guessed | (1u << i), len, nullptr));
+        }
+        if (cost < best) {
+            best = cost;
+            if (bestLetter){
+                *bestLetter = char('A' + i);
+            }
+        }
+    }
+    return best;
+}
+
+DecisionTree::DecisionTree() {
+    std::fill(roots_, roots_ + MAX_LEN + 1, NO_ROOT);
+}
+
+uint32_t DecisionTree::buildNode(const std::vector<const std::string*>& words, uint32_t guessed, size_t len) {
+    char letter = 0;
+    if (words.size() == 1) {
+        for (size_t i = 0; i < len && !letter; ++i) { //word known, spell out what is left
+            char c = (*words[0])[i];
+            if (!(guessed & (1u << (c - 'A')))){
+                letter = c;
+            }
+        }
+    } else if (words.size() <= EXACT_LIMIT) {
+        exactCost(words, guessed, len, &letter);
+    } else {
+        //greedy: fewest expected misses now, most even split on ties
+        size_t bestHits = 0;
+        double bestSplit = -1.0;
+        for (int i = 0; i < 26; ++i) {
+            if (guessed & (1u << i)){
+                continue;
+            }
+            WordGroups groups = splitBy(words, len, char('A' + i));
+            auto miss = groups.find(0);
+            size_t hits = words.size() - (miss == groups.end() ? 0 : miss->second.size());
+            double split = 0.0;
+            for (const auto& g : groups) {
+                double p = double(g.second.size()) / double(words.size());
+                split -= p * std::log2(p);
+            }
+            if (hits > bestHits || (hits == bestHits && hits > 0 && split > bestSplit)) {
+                bestHits = hits;
+                bestSplit = split;
+                letter = char('A' + i);
+            }
+        }
+    }
+
+    uint32_t idx = (uint32_t)nodes_.size();
+    nodes_.push_back({letter, 0, (uint32_t)edges_.size()});
+    if (!letter){
+        return idx; //solved
+    }
+
+    WordGroups groups = splitBy(words, len, letter);
+    uint32_t first = (uint32_t)edges_.size();
+    edges_.resize(edges_.size() + groups.size());
+    nodes_[idx].edgeCount = (uint32_t)groups.size();
+    nodes_[idx].firstEdge = first;
+    uint32_t k = first;
+    for (const auto& g : groups) { //map order keeps edges sorted by positions
+        uint32_t child = buildNode(g.second, guessed | (1u << (letter - 'A')), len);
+        edges_[k++] = {g.first, child};
+    }
+    return idx;
+}
+
+void DecisionTree::build(const Dictionary& dict) {
+    nodes_.clear();
+    edges_.clear();
+    std::fill(roots_, roots_ + MAX_LEN + 1, NO_ROOT);
+    for (size_t len = 1; len <= MAX_LEN; ++len) {
+        const std::vector<std::string>& list = dict.wordsOfLength(len);
+        if (list.empty()){
+            continue;
+        }
+        std::vector<const std::string*> words;
+        for (const std::string& w : list){
+            words.push_back(&w);
+        }
+        roots_[len] = buildNode(words, 0, len);
+    }
+}
+
+char DecisionTree::play(const std::string& pattern, uint32_t guessed) const {
+    size_t len = pattern.size();
+    if (len == 0 || len > MAX_LEN || roots_[len] == NO_ROOT){
+        return 0;
+    }
+    uint32_t at = roots_[len];
+    while (true) {
+        const Node& n = nodes_[at];
+        if (!n.letter){
+            return 0;
+        }
+        if (!(guessed & (1u << (n.letter - 'A')))){
+            return n.letter;
+        }
+        //already played, follow what it revealed
+        uint32_t seen = positionsOf(pattern.data(), len, n.letter);
+        const Edge* begin = edges_.data() + n.firstEdge;
+        const Edge* end = begin + n.edgeCount;
+        const Edge* e = std::lower_bound(begin, end, seen,
+                                         [](const Edge& a, uint32_t m) { return a.positions < m; });
+        if (e == end || e->positions != seen){
+            return 0; //word not in the dictionary the tree was built from
+        }
+        at = e->child;
+    }
+}
+
+bool DecisionTree::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[4];
+    uint32_t counts[2];
+    if (!in.read(magic, 4) || std::memcmp(magic, TREE_MAGIC, 4) != 0){
+        return false;
+    }
+    if (!in.read(reinterpret_cast<char*>(counts), sizeof(counts))){
+        return false;
+    }
+    uint32_t roots[MAX_LEN + 1];
+    //counts must add up to the file size before anything is allocated from them
+    std::streamoff header = in.tellg();
+    in.seekg(0, std::ios::end);
+    uint64_t fileSize = (uint64_t)(std::streamoff)in.tellg();
+    in.seekg(header);
+    if (fileSize != (uint64_t)header + sizeof(roots) + (uint64_t)counts[0] * sizeof(Node)
+                    + (uint64_t)counts[1] * sizeof(Edge)){
+        return false;
+    }
+    std::vector<Node> nodes(counts[0]);
+    std::vector<Edge> edges(counts[1]);
+    if (!in.read(reinterpret_cast<char*>(roots), sizeof(roots))
+        || !in.read(reinterpret_cast<char*>(nodes.data()), nodes.size() * sizeof(Node))
+        || !in.read(reinterpret_cast<char*>(edges.data()), edges.size() * sizeof(Edge))){
+        return false;
+    }
+    for (const Node& n : nodes) { //reject files that would walk out of bounds
+        if ((uint64_t)n.firstEdge + n.edgeCount > edges.size()){
+            return false;
+        }
+    }
+    for (const Edge& e : edges) {
+        if (e.child >= nodes.size()){
+            return false;
+        }
+    }
+    for (uint32_t r : roots) {
+        if (r != NO_ROOT && r >= nodes.size()){
+            return false;
+        }
+    }
+    std::copy(roots, roots + MAX_LEN + 1, roots_);
+    nodes_.swap(nodes);
+    edges_.swap(edges);
+    return true;
+}
+
+bool DecisionTree::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    uint32_t counts[2] = {(uint32_t)nodes_.size(), (uint32_t)edges_.size()};
+    out.write(TREE_MAGIC, 4);
+    out.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+    out.write(reinterpret_cast<const char*>(roots_), sizeof(roots_));
+    out.write(reinterpret_cast<const char*>(nodes_.data()), nodes_.size() * sizeof(Node));
+    out.write(reinterpret_cast<const char*>(edges_.data()), edges_.size() * sizeof(Edge));
+    return bool(out);
+}
+
+DecisionTreeStrategy::DecisionTreeStrategy(std::shared_ptr<const DecisionTree> tree,
+                                           std::unique_ptr<GuessStrategy> fallback)
+    : tree_(std::move(tree)), fallback_(std::move(fallback))
+{
+}
+
+char DecisionTreeStrategy::pick(const GuessState& state) {
+    if (tree_) {
+        for (const std::string& pattern : unsolvedWords(state.masked)) {
+            char c = tree_->play(pattern, state.guessed);
+            if (c){
+                return c;
+            }
+        }
+    }
+    return fallback_ ? fallback_->pick(state) : 0;
+}
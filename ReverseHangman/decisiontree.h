@@ -0,0 +1,58 @@
+#ifndef DECISIONTREE_H
+#define DECISIONTREE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "solver.h"
+
+//offline guess tree per word length (tools/makedecisiontree), stored as flat arrays
+//node = letter to guess, edges = where that letter showed up (positions mask, 0 = miss)
+class DecisionTree {
+public:
+    static const int MAX_LEN = 32;
+    static const size_t EXACT_LIMIT = 4; //candidate sets this small get an exhaustive search
+
+    struct Node {
+        char letter;        //0 = word solved
+        uint32_t edgeCount;
+        uint32_t firstEdge;
+    };
+    struct Edge {
+        uint32_t positions; //bit i = letter at position i
+        uint32_t child;
+    };
+
+    DecisionTree();
+
+    void build(const Dictionary& dict); //every length; fewest expected misses only for sets of up to EXACT_LIMIT words, greedy above
+    bool load(const std::string& path); //false if missing, truncated or inconsistent
+    bool save(const std::string& path) const;
+
+    //next letter for one masked word given all guessed letters, 0 if solved/off the tree
+    char play(const std::string& pattern, uint32_t guessed) const;
+
+    size_t nodeCount() const { return nodes_.size(); }
+
+private:
+    uint32_t buildNode(const std::vector<const std::string*>& words, uint32_t guessed, size_t len);
+
+    static constexpr uint32_t NO_ROOT = 0xFFFFFFFFu; //constexpr: std::fill takes it by reference
+    uint32_t roots_[MAX_LEN + 1];
+    std::vector<Node> nodes_;
+    std::vector<Edge> edges_; //sorted by positions inside each node
+};
+
+//plays the first unsolved word the tree knows, otherwise asks the fallback strategy
+class DecisionTreeStrategy final : public GuessStrategy {
+public:
+    DecisionTreeStrategy(std::shared_ptr<const DecisionTree> tree, std::unique_ptr<GuessStrategy> fallback);
+    char pick(const GuessState& state) override;
+
+private:
+    std::shared_ptr<const DecisionTree> tree_;
+    std::unique_ptr<GuessStrategy> fallback_;
+};
+
+#endif // DECISIONTREE_H
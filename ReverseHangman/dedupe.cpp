@@ -0,0 +1,171 @@
+#include "dedupe.h"
+#include "solver.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+PhraseDedupe::PhraseDedupe(size_t memoryBytes) {
+    size_t bloomBytes = std::max<size_t>(memoryBytes / 8, sizeof(Block));
+    blocks_.assign(bloomBytes / sizeof(Block), Block{});
+    size_t exactBudget = memoryBytes - std::min(memoryBytes, blocks_.size() * sizeof(Block));
+    size_t slots = 1;
+    while (slots * 2 * sizeof(Slot) <= exactBudget / 2){ //half the exact budget for slots, half for text
+        slots *= 2;
+    }
+    slots_.assign(slots, Slot{0, 0}); //sized once, never rehashed
+    exactFull_ = slots < 2;
+    text_.reserve(exactBudget - slots * sizeof(Slot)); //no copy on growth, pages only touched as used
+}
+
+//splitmix64 finalizer, spreads std::hash output over block index and bit positions
+static uint64_t remix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+uint64_t PhraseDedupe::hashOf(const char* phrase, size_t length) {
+    return remix(std::hash<std::string_view>()(std::string_view(phrase, length))) | 1; //never 0, that marks an empty slot
+}
+
+void PhraseDedupe::prefetch(uint64_t h) const {
+    __builtin_prefetch(&blocks_[((h >> 32) * blocks_.size()) >> 32], 1);
+    __builtin_prefetch(&slots_[h & (slots_.size() - 1)], 1);
+}
+
+bool PhraseDedupe::testAndSet(uint64_t h) {
+    Block& b = blockOf(h);
+    uint64_t bits[2] = {remix(h), remix(h ^ 0x9E3779B97F4A7C15ull)}; //72 bits needed, 4 probes per word
+    bool present = true;
+    for (int k = 0; k < BITS_PER_KEY; ++k) {
+        uint64_t pos = bits[k / 4] >> (9 * (k % 4)); //9 bits pick one of the block's 512
+        uint64_t mask = 1ull << (pos & 63);
+        uint64_t& w = b.words[(pos >> 6) & 7];
+        present = present && (w & mask);
+        w |= mask;
+    }
+    return present;
+}
+
+PhraseDedupe::Slot* PhraseDedupe::findSlot(uint64_t h, const char* phrase, size_t length) {
+    size_t mask = slots_.size() - 1; //power of two
+    for (size_t i = h & mask;; i = (i + 1) & mask) {
+        Slot& s = slots_[i];
+        if (s.hash == 0){
+            return &s;
+        }
+        if (s.hash == h) {
+            uint32_t len;
+            std::memcpy(&len, &text_[s.offset], sizeof(len));
+            if (len == length && std::memcmp(&text_[s.offset + sizeof(len)], phrase, len) == 0){
+                return &s;
+            }
+        }
+    }
+}
+
+bool PhraseDedupe::insert(const char* phrase, size_t length) {
+    return insertHashed(hashOf(phrase, length), phrase, length);
+}
+
+void PhraseDedupe::insertBatch(const std::vector<std::string>& phrases, const std::vector<uint64_t>& hashes,
+                               std::vector<char>& keep) {
+    size_t n = phrases.size();
+    keep.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (i + PREFETCH_AHEAD < n){
+            prefetch(hashes[i + PREFETCH_AHEAD]);
+        }
+        keep[i] = insertHashed(hashes[i], phrases[i].data(), phrases[i].size());
+    }
+}
+
+void PhraseDedupe::insertShard(const std::vector<std::string>& phrases, const std::vector<uint64_t>& hashes,
+                               std::vector<char>& keep, size_t shard, size_t shards) {
+    shardLines_.clear();
+    for (size_t i = 0; i < phrases.size(); ++i) {
+        if (shardOf(hashes[i], shards) == shard){
+            shardLines_.push_back((uint32_t)i);
+        }
+    }
+    size_t n = shardLines_.size();
+    for (size_t j = 0; j < n; ++j) {
+        if (j + PREFETCH_AHEAD < n){
+            prefetch(hashes[shardLines_[j + PREFETCH_AHEAD]]);
+        }
+        size_t i = shardLines_[j];
+        keep[i] = insertHashed(hashes[i], phrases[i].data(), phrases[i].size());
+    }
+}
+
+bool PhraseDedupe::insertHashed(uint64_t h, const char* phrase, size_t length) {
+    ++seen_;
+    bool maybe = testAndSet(h);
+    Slot* slot = nullptr;
+    if (maybe) {
+        slot = findSlot(h, phrase, length);
+        if (slot->hash) {
+            ++duplicates_;
+            return false;
+        }
+        if (exactFull_) {
+            ++unconfirmed_; //can't tell, keep it
+            return true;
+        }
+        ++falsePositives_;
+    }
+    if (exactFull_){
+        return true;
+    }
+    if ((exactCount_ + 1) * 2 > slots_.size() || text_.size() + sizeof(uint32_t) + length > text_.capacity()) {
+        exactFull_ = true; //load stays under 1/2, text never reallocates
+        return true;
+    }
+    if (!slot){
+        slot = findSlot(h, phrase, length);
+    }
+    uint32_t len = (uint32_t)length;
+    slot->hash = h;
+    slot->offset = text_.size();
+    text_.append(reinterpret_cast<const char*>(&len), sizeof(len));
+    text_.append(phrase, length);
+    ++exactCount_;
+    return true;
+}
+
+ShardedPhraseDedupe::ShardedPhraseDedupe(size_t memoryBytes, size_t shards) {
+    shards = std::min<size_t>(std::max<size_t>(shards, 1), 64); //shardOf has 6 bits
+    shards_.reserve(shards);
+    for (size_t k = 0; k < shards; ++k){
+        shards_.emplace_back(memoryBytes / shards);
+    }
+}
+
+void ShardedPhraseDedupe::insertBatch(const std::vector<std::string>& phrases, const std::vector<uint64_t>& hashes,
+                                      std::vector<char>& keep, WorkerPool& pool) {
+    if (shards_.size() == 1){
+        shards_[0].insertBatch(phrases, hashes, keep);
+        return;
+    }
+    keep.resize(phrases.size());
+    pool.run(shards_.size(), [&](size_t k) { shards_[k].insertShard(phrases, hashes, keep, k, shards_.size()); });
+}
+
+uint64_t ShardedPhraseDedupe::sum(uint64_t (PhraseDedupe::*stat)() const) const {
+    uint64_t total = 0;
+    for (const PhraseDedupe& d : shards_){
+        total += (d.*stat)();
+    }
+    return total;
+}
+
+size_t ShardedPhraseDedupe::memoryUsed() const {
+    size_t total = 0;
+    for (const PhraseDedupe& d : shards_){
+        total += d.memoryUsed();
+    }
+    return total;
+}
@@ -0,0 +1,93 @@
+#ifndef DEDUPE_H
+#define DEDUPE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class WorkerPool;
+
+//streaming duplicate filter for corpus phrases (already normalized) within a memory budget
+//a blocked bloom filter answers "never seen" without touching the exact set; a "maybe" is only
+//called a duplicate after an exact compare, so a phrase is never dropped by mistake; once the
+//exact set is full, new phrases are still recorded in the bloom filter but repeats of them pass
+class PhraseDedupe {
+public:
+    static const size_t DEFAULT_MEMORY = size_t(64) << 20; //bytes, 1/8 bloom filter, rest exact set (slots + text)
+
+    explicit PhraseDedupe(size_t memoryBytes = DEFAULT_MEMORY);
+
+    bool insert(const char* phrase, size_t length); //true = first time (keep), false = confirmed duplicate
+    bool insert(const std::string& phrase) { return insert(phrase.data(), phrase.size()); }
+
+    static uint64_t hash(const std::string& phrase) { return hashOf(phrase.data(), phrase.size()); } //thread safe
+    //insert() on each phrase in order, hashes[i] = hash(phrases[i]) (computed by the caller, e.g. on
+    //several threads); prefetches a few phrases ahead so the bloom/slot cache misses overlap
+    void insertBatch(const std::vector<std::string>& phrases, const std::vector<uint64_t>& hashes,
+                     std::vector<char>& keep);
+    //same, for only the phrases whose hash falls in shard (of shards); keep is already sized and
+    //each shard writes only its own entries, so shards of one batch can run at the same time
+    void insertShard(const std::vector<std::string>& phrases, const std::vector<uint64_t>& hashes,
+                     std::vector<char>& keep, size_t shard, size_t shards);
+    static size_t shardOf(uint64_t h, size_t shards) { return (((h >> 26) & 63) * shards) >> 6; } //bits no block/slot index uses
+
+    uint64_t seen() const { return seen_; }
+    uint64_t duplicates() const { return duplicates_; }
+    uint64_t falsePositives() const { return falsePositives_; } //bloom said maybe, exact set said new
+    uint64_t unconfirmed() const { return unconfirmed_; } //bloom said maybe, exact set was full
+    size_t memoryUsed() const { return blocks_.size() * sizeof(Block) + exactBytes(); }
+
+private:
+    struct alignas(64) Block { //one cache line, all k bits of a phrase land here
+        uint64_t words[8];
+    };
+    struct Slot { //exact set entry, hash 0 = empty
+        uint64_t hash;
+        uint64_t offset; //into text_, a 4-byte length then the phrase
+    };
+    static const int BITS_PER_KEY = 8; //at most 8: two 64-bit hashes, 4 probes of 9 bits each
+    static const size_t PREFETCH_AHEAD = 8; //phrases
+
+    static uint64_t hashOf(const char* phrase, size_t length);
+    bool insertHashed(uint64_t h, const char* phrase, size_t length);
+    void prefetch(uint64_t h) const;
+    Block& blockOf(uint64_t h) { return blocks_[((h >> 32) * blocks_.size()) >> 32]; } //multiply-shift, no division
+    bool testAndSet(uint64_t h); //true if every bit was already set
+    Slot* findSlot(uint64_t h, const char* phrase, size_t length); //matching slot, or the empty one it would go in
+    size_t exactBytes() const { return slots_.size() * sizeof(Slot) + text_.size(); } //text only counts once touched
+
+    std::vector<Block> blocks_;
+    std::vector<Slot> slots_; //open addressing, linear probing, no per-phrase allocation
+    std::string text_; //every phrase of the exact set back to back
+    size_t exactCount_ = 0;
+    bool exactFull_ = false;
+    uint64_t seen_ = 0;
+    uint64_t duplicates_ = 0;
+    uint64_t falsePositives_ = 0;
+    uint64_t unconfirmed_ = 0;
+    std::vector<uint32_t> shardLines_; //insertShard's indices, reused
+};
+
+//PhraseDedupe split by hash into shards that share the memory budget, one pool task per shard, so
+//the inserts of a batch are not a serial stage; equal phrases land in the same shard, so the
+//first of them is still the one kept
+class ShardedPhraseDedupe {
+public:
+    ShardedPhraseDedupe(size_t memoryBytes, size_t shards); //shards <= 64
+
+    void insertBatch(const std::vector<std::string>& phrases, const std::vector<uint64_t>& hashes,
+                     std::vector<char>& keep, WorkerPool& pool);
+
+    uint64_t seen() const { return sum(&PhraseDedupe::seen); }
+    uint64_t duplicates() const { return sum(&PhraseDedupe::duplicates); }
+    uint64_t falsePositives() const { return sum(&PhraseDedupe::falsePositives); }
+    uint64_t unconfirmed() const { return sum(&PhraseDedupe::unconfirmed); }
+    size_t memoryUsed() const;
+
+private:
+    uint64_t sum(uint64_t (PhraseDedupe::*stat)() const) const;
+
+    std::vector<PhraseDedupe> shards_;
+};
+
+#endif // DEDUPE_H
@@ -0,0 +1,73 @@
+#include "frontcoded.h"
+#include <algorithm>
+
+void FrontCodedDictionary::build(const Dictionary& dict, size_t blockSize) {
+    blockSize_ = std::min<size_t>(std::max<size_t>(blockSize, 16), 64);
+    lists_.assign(33, List());
+    count_ = 0;
+    for (size_t len = 1; len <= 32; ++len) {
+        std::vector<std::string> words = dict.wordsOfLength(len);
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+        List& L = lists_[len];
+        L.words = words.size();
+        count_ += words.size();
+        for (size_t i = 0; i < words.size(); ++i) {
+            size_t shared = 0;
+            if (i % blockSize_ == 0) {
+                L.directory.push_back((uint32_t)L.data.size());
+            } else {
+                const std::string& prev = words[i - 1];
+                while (shared < len && prev[shared] == words[i][shared]){
+                    ++shared;
+                }
+                L.data.push_back(char(shared));
+            }
+            L.data.insert(L.data.end(), words[i].begin() + shared, words[i].end());
+        }
+        L.data.shrink_to_fit();
+        L.directory.shrink_to_fit();
+    }
+}
+
+std::string FrontCodedDictionary::word(size_t len, size_t i) const {
+    if (i >= wordsOfLength(len)){
+        return std::string();
+    }
+    const List& L = lists_[len];
+    const char* p = L.data.data() + L.directory[i / blockSize_];
+    std::string w(len, ' ');
+    for (size_t k = 0; k <= i % blockSize_; ++k) {
+        size_t shared = k ? (unsigned char)*p++ : 0;
+        for (size_t j = shared; j < len; ++j){
+            w[j] = *p++;
+        }
+    }
+    return w;
+}
+
+size_t FrontCodedDictionary::memoryBytes() const {
+    size_t n = lists_.size() * sizeof(List);
+    for (const List& L : lists_){
+        n += L.data.capacity() + L.directory.capacity() * sizeof(uint32_t);
+    }
+    return n;
+}
+
+void FrontCodedDictionary::countLetters(const std::string& pattern, uint32_t guessed, CandidateStats& stats) const {
+    stats = CandidateStats();
+    size_t len = pattern.size();
+    forEachWord(len, [&](const char* w) {
+        if (!matchesPattern(w, pattern.data(), len, guessed)){
+            return;
+        }
+        ++stats.total;
+        uint32_t letters = 0;
+        for (size_t i = 0; i < len; ++i){
+            letters |= 1u << (w[i] - 'A');
+        }
+        for (uint32_t m = letters & ~guessed; m; m &= m - 1){
+            ++stats.contains[__builtin_ctz(m)];
+        }
+    });
+}
@@ -0,0 +1,62 @@
+#ifndef FRONTCODED_H
+#define FRONTCODED_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "solver.h"
+#include "solvercache.h"
+
+//sorted words of each length, front coded in blocks: the first word of a block is stored whole,
+//the rest as (shared prefix length byte, remaining letters); words of one list share a length,
+//so suffix lengths are implicit; a block directory gives random access
+//benchmark layout only (tools/dictbench, not in HangmanEngine): ~7x smaller than the solver's
+//vector<string> lists but ~1.4-1.7x slower to scan, so no strategy uses it
+class FrontCodedDictionary {
+public:
+    static const size_t DEFAULT_BLOCK = 32; //words per block (16..64)
+
+    void build(const Dictionary& dict, size_t blockSize = DEFAULT_BLOCK);
+
+    size_t size() const { return count_; }
+    size_t wordsOfLength(size_t len) const { return len < lists_.size() ? lists_[len].words : 0; }
+    std::string word(size_t len, size_t i) const; //decodes one block
+    size_t memoryBytes() const;
+
+    //streams every word of the length in sorted order: fn(const char* word), word valid during the call
+    template <typename Fn>
+    void forEachWord(size_t len, Fn fn) const {
+        if (len >= lists_.size()){
+            return;
+        }
+        const List& L = lists_[len];
+        char buf[33];
+        for (size_t b = 0; b < L.directory.size(); ++b) {
+            const char* p = L.data.data() + L.directory[b];
+            size_t n = std::min(blockSize_, L.words - b * blockSize_);
+            for (size_t i = 0; i < n; ++i) {
+                size_t shared = i ? (unsigned char)*p++ : 0;
+                std::memcpy(buf + shared, p, len - shared);
+                p += len - shared;
+                fn(static_cast<const char*>(buf));
+            }
+        }
+    }
+
+    //same counts as a scan with matchesPattern, decoded block by block
+    void countLetters(const std::string& pattern, uint32_t guessed, CandidateStats& stats) const;
+
+private:
+    struct List {
+        size_t words = 0;
+        std::vector<char> data;          //blocks back to back
+        std::vector<uint32_t> directory; //offset of each block in data
+    };
+    size_t blockSize_ = DEFAULT_BLOCK;
+    size_t count_ = 0;
+    std::vector<List> lists_;
+};
+
+#endif // FRONTCODED_H
@@ -1,10 +1,20 @@
 #include "gameengine.h"
-#include <cctype>
+#include "decisiontree.h"
+#include "ngrammodel.h"
+#include "normalize.h"
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <iterator>
 #include <sstream>
 
 //fill queue with letters (by frequency in english)
-LetterQueue::LetterQueue() {
-    std::string order = "ETAOINSHRDLUCMWFGYPBVKJXQZ";
+LetterQueue::LetterQueue()
+    : LetterQueue("ETAOINSHRDLUCMWFGYPBVKJXQZ")
+{
+}
+
+LetterQueue::LetterQueue(const std::string& order) {
     for (char c : order){
         data.push_back(c);
     }
@@ -12,8 +22,18 @@ LetterQueue::LetterQueue() {
 
 //name and index of each limb
 LimbList::LimbList() {
+    reset();
+}
+
+void LimbList::reset() {
+    LimbNode* cur = head; //drop what is left of the old list
+    while (cur) {
+        LimbNode* nxt = cur->next;
+        delete cur;
+        cur = nxt;
+    }
     // indices for limbs
-    const char* names[GameEngine::TOTAL_LIMBS] = {
+    const char* names[GameEngineBase::TOTAL_LIMBS] = {
         "Head",          // 0
         "Torso",         // 1
         "Left bicep",    // 2
@@ -30,7 +50,7 @@ LimbList::LimbList() {
     //node creation for limb list
     head = nullptr;
     LimbNode* tail = nullptr;
-    for (int i = 0; i < GameEngine::TOTAL_LIMBS; ++i) {
+    for (int i = 0; i < GameEngineBase::TOTAL_LIMBS; ++i) {
         LimbNode* node = new LimbNode(names[i], i);
         if (!head) {
             head = node;
@@ -78,14 +98,14 @@ void LimbList::removeByIndex(int idx) {
 
 BodyTree::BodyTree() {
     root = new TreeNode("Body", -1); //root node for full body
-    const char* names[GameEngine::TOTAL_LIMBS] = {
+    const char* names[GameEngineBase::TOTAL_LIMBS] = {
         "Head","Torso",
         "Left bicep","Left forearm","Left hand",
         "Left thigh","Left calf",
         "Right bicep","Right forearm","Right hand",
         "Right thigh","Right calf"
     };
-    for (int i = 0; i < GameEngine::TOTAL_LIMBS; ++i) {
+    for (int i = 0; i < GameEngineBase::TOTAL_LIMBS; ++i) {
         root->children.push_back(new TreeNode(names[i], i));
     }
 }
@@ -130,6 +150,12 @@ void BodyTree::markLost(int limbIndex) {
     }
 }
 
+void BodyTree::reset() {
+    for (TreeNode* ch : root->children){
+        ch->lost = false;
+    }
+}
+
 void BodyTree::collectLost(TreeNode* node, std::vector<bool>& out) const {
     if (!node){
         return;
@@ -143,12 +169,12 @@ void BodyTree::collectLost(TreeNode* node, std::vector<bool>& out) const {
 }
 
 void BodyTree::getLost(std::vector<bool>& lost) const {
-    lost.assign(GameEngine::TOTAL_LIMBS, false);
+    lost.assign(GameEngineBase::TOTAL_LIMBS, false);
     collectLost(root, lost);
 }
 
 BodyGraph::BodyGraph() {
-    int n = GameEngine::TOTAL_LIMBS;
+    int n = GameEngineBase::TOTAL_LIMBS;
     adj.assign(n, {});
 
     auto addEdge = [&](int u, int v) {
@@ -190,87 +216,160 @@ std::string BodyGraph::neighborsOf(int limbIndex) const {
     return oss.str();
 }
 
-// normalize to letters and spaces only + convert to uppercase
-static std::string normalize(const std::string& s) {
-    std::string r;
-    for (char c : s) {
-        if (std::isalpha((unsigned char)c) || c==' '){
-            r.push_back(std::toupper((unsigned char)c));
-        }
-    }
-    return r;
-}
-
 // game engine core
-GameEngine::GameEngine() {
+GameEngineBase::GameEngineBase() {
     for (bool &b : guessedHash_){
         b = false;
     }
 }
 
-void GameEngine::setSecret(const std::string& phrase) {
-    secret_ = normalize(phrase);
-    revealed_.assign(secret_.size(), false);
+void GameEngineBase::setSecret(const std::string& phrase) {
+    setNormalizedSecret(normalizePhrase(language_ ? language_->fold(phrase) : phrase)); //letters and spaces only, uppercase
+}
+
+void GameEngineBase::setNormalizedSecret(std::string secret) {
+    secret_ = std::move(secret);
+    std::fill(std::begin(letterCount_), std::end(letterCount_), 0);
+    size_t kept = 0;
+    for (char c : secret_) { //only A-Z and spaces: anything else would index past letterCount_
+        if (c >= 'A' && c <= 'Z'){
+            ++letterCount_[c - 'A'];
+        } else if (c != ' '){
+            continue; //not normalized, dropped in release builds
+        }
+        secret_[kept++] = c;
+    }
+    assert(kept == secret_.size() && "setNormalizedSecret needs normalizePhrase output");
+    secret_.resize(kept);
+    hiddenCount_ = 0;
+    for (size_t n : letterCount_){
+        hiddenCount_ += n;
+    }
     guessesUsed_ = 0;
     gameOver_ = false;
     playerWon_ = false;
     limbsRemaining_ = TOTAL_LIMBS;
-
-    guessQueue_ = LetterQueue(); // reset ai guess queue and guessed hash set
+    limbList_.reset(); //new game gets the whole body back
+    bodyTree_.reset();
+    moveStack_.clear();
+
+    // reset ai guess queue and guessed hash set
+    std::string base = language_ ? language_->order() : letterOrder(); //pack or order.txt, else english
+    if (letterModel_) {
+        guessQueue_ = LetterQueue(letterModel_->order(base)); //base reordered by earlier games only,
+        letterModel_->observe(secret_);                       //this secret counts from the next game on
+    } else {
+        guessQueue_ = LetterQueue(base);
+    }
     for (bool &b : guessedHash_){
         b = false;
     }
 }
 
-// true when all letters are guessed correctly
-bool GameEngine::allRevealed() const {
-    for (size_t i = 0; i < secret_.size(); ++i) {
-        if (secret_[i] != ' ' && !revealed_[i]){
-            return false;
+bool GameEngineBase::setLetterOrder(const std::string& order) {
+    std::string out;
+    for (char c : normalizePhrase(order)) {
+        if (c != ' ' && out.find(c) == std::string::npos){
+            out.push_back(c);
+        }
+    }
+    if (out.empty()){
+        return false;
+    }
+    for (char c : std::string("ETAOINSHRDLUCMWFGYPBVKJXQZ")) { //letters the order left out go last
+        if (out.find(c) == std::string::npos){
+            out.push_back(c);
         }
     }
+    letterOrder_ = out;
     return true;
 }
 
-std::string GameEngine::maskedPhrase() const {
-    std::string out;
-    for (size_t i = 0; i < secret_.size(); ++i) {
-        if (secret_[i] == ' '){
-            out.push_back(' ');
-        }
-        else if (revealed_[i]){
-            out.push_back(secret_[i]);
-        }
-        else{
-            out.push_back('_');
+bool GameEngineBase::loadLetterOrder(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    return std::getline(in, line) && setLetterOrder(line);
+}
+
+std::string GameEngineBase::letterOrder() const {
+    return letterOrder_.empty() ? std::string("ETAOINSHRDLUCMWFGYPBVKJXQZ") : letterOrder_;
+}
+
+// true when all letters are guessed correctly
+bool GameEngineBase::allRevealed() const {
+    return hiddenCount_ == 0;
+}
+
+std::string GameEngineBase::maskedPhrase() const {
+    return maskedWindow(0, secret_.size());
+}
+
+std::string GameEngineBase::maskedWindow(size_t offset, size_t length) const {
+    offset = std::min(offset, secret_.size());
+    length = std::min(length, secret_.size() - offset);
+    std::string out(length, '_');
+    for (size_t i = 0; i < length; ++i) {
+        char c = secret_[offset + i];
+        if (c == ' ' || guessedHash_[c - 'A']){ //guessed letters are always revealed
+            out[i] = c;
         }
     }
     return out;
 }
 
+bool GameEngine::loadDecisionTree(const std::string& path) {
+    auto tree = std::make_shared<DecisionTree>();
+    if (!tree->load(path)){
+        return false;
+    }
+    strategy().impl_ = std::make_unique<DecisionTreeStrategy>(tree, std::move(strategy().impl_));
+    return true;
+}
+
+bool GameEngine::loadNGramModel(const std::string& path) {
+    auto model = std::make_shared<NGramModel>();
+    if (!model->load(path)){
+        return false;
+    }
+    strategy().impl_ = std::make_unique<FallbackStrategy>(std::move(strategy().impl_),
+                                                          std::make_unique<NGramStrategy>(model));
+    return true;
+}
+
+GuessState GameEngineBase::guessState() const {
+    GuessState st;
+    st.masked = maskedPhrase();
+    for (int i = 0; i < 26; ++i) {
+        if (guessedHash_[i]){
+            st.guessed |= 1u << i;
+        }
+    }
+    return st;
+}
+
+bool GameEngineBase::useLetter(char c) {
+    if (c < 'A' || c > 'Z' || guessedHash_[c - 'A']){
+        return false;
+    }
+    guessedHash_[c - 'A'] = true;
+    return true;
+}
+
 // dequeue next unused letter from queue
-char GameEngine::pickNextLetter() {
+char GameEngineBase::queueLetter() {
     while (!guessQueue_.empty()) {
         char c = guessQueue_.front();
         guessQueue_.pop();
-        int idx = c - 'A';
-        if (!guessedHash_[idx]) {
-            guessedHash_[idx] = true;
+        if (useLetter(c)){
             return c;
         }
     }
     return 0; // all letters used
 }
 
-// one ai guess and game state update, mainwindow can then force sacrifice if hit
-TurnInfo GameEngine::nextTurn() {
+// apply one ai guess and update game state, mainwindow can then force sacrifice if hit
+TurnInfo GameEngineBase::playGuess(char g) {
     TurnInfo info;
-    if (gameOver_) {
-        info.gameOver = true;
-        return info;
-    }
-
-    char g = pickNextLetter();
     if (g == 0) { // ai out of guesses (win)
         gameOver_ = true;
         playerWon_ = true;
@@ -283,13 +382,9 @@ TurnInfo GameEngine::nextTurn() {
     ++guessesUsed_;
     info.guess = g;
 
-    bool hit = false;
-    for (size_t i = 0; i < secret_.size(); ++i) { //reveal all occurences of correctly guessed letter
-        if (secret_[i] == g) {
-            revealed_[i] = true;
-            hit = true;
-        }
-    }
+    size_t found = letterCount_[g - 'A']; //g is now guessed, so all its occurrences show
+    bool hit = found > 0;
+    hiddenCount_ -= found;
     info.hit = hit;
 
     if (hit){
@@ -318,7 +413,7 @@ TurnInfo GameEngine::nextTurn() {
 }
 
 //after limb sacrifice
-void GameEngine::loseLimb(int limbIndex) {
+void GameEngineBase::loseLimb(int limbIndex) {
     if (limbIndex < 0 || limbIndex >= TOTAL_LIMBS){
         return;
     }
@@ -328,13 +423,13 @@ void GameEngine::loseLimb(int limbIndex) {
     --limbsRemaining_;
 }
 
-std::vector<bool> GameEngine::lostLimbs() const {
+std::vector<bool> GameEngineBase::lostLimbs() const {
     std::vector<bool> lost;
     bodyTree_.getLost(lost);
     return lost;
 }
 
-std::string GameEngine::limbName(int index) const {
+std::string GameEngineBase::limbName(int index) const {
     static const char* names[TOTAL_LIMBS] = {
         "Head","Torso",
         "Left bicep","Left forearm","Left hand",
@@ -346,6 +441,6 @@ std::string GameEngine::limbName(int index) const {
     return names[index];
 }
 
-std::vector<std::pair<int,std::string>> GameEngine::availableLimbs() const {
+std::vector<std::pair<int,std::string>> GameEngineBase::availableLimbs() const {
     return limbList_.toVector();
 }
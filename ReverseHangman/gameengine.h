@@ -1,8 +1,15 @@
 #ifndef GAMEENGINE_H
 #define GAMEENGINE_H
 
+#include <chrono>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#include "language.h"
+#include "lettermodel.h"
+#include "solver.h"
 
 //stack to record moves
 class MoveStack {
@@ -12,6 +19,7 @@ public:
     bool empty() const { return data.empty(); }
     int top() const { return data.back(); }
     void pop() { if (!data.empty()) data.pop_back(); }
+    void clear() { data.clear(); }
 };
 
 //queue of letters the ai will try (by order of frequency in english)
@@ -20,6 +28,7 @@ class LetterQueue {
     size_t frontIndex = 0;  //current front
 public:
     LetterQueue(); //fills queue
+    explicit LetterQueue(const std::string& order); //custom order, e.g. learned from past games
     bool empty() const { return frontIndex >= data.size(); }
     char front() const { return data[frontIndex]; }
     void pop() { if (!empty()) ++frontIndex; }
@@ -39,6 +48,7 @@ class LimbList {
 public:
     LimbList(); //build list
     ~LimbList();  //free nodes
+    void reset(); //all 12 limbs again (new game)
     bool empty() const { return head == nullptr; }
     std::vector<std::pair<int, std::string>> toVector() const; //returns vector of pairs for GUI (index, name)
     void removeByIndex(int idx); //remove limb by index after lost
@@ -63,6 +73,7 @@ public:
     BodyTree();
     ~BodyTree();
     void markLost(int limbIndex);  //mark as lost
+    void reset(); //nothing lost (new game)
     void getLost(std::vector<bool>& lost) const; //fills with lost limbs
 };
 
@@ -83,14 +94,23 @@ struct TurnInfo {
     std::string message; //text for UI
 };
 
-class GameEngine {
+//rules, phrase and limbs shared by every engine, the letter choice lives in BasicGameEngine
+class GameEngineBase {
 public:
     static constexpr int TOTAL_LIMBS = 12;
+    static constexpr int MAX_GUESSES = 18; //number of tries for AI
 
-    GameEngine();
+    GameEngineBase();
+
+    static const size_t LARGE_SECRET = 1 << 16; //longer secrets (chapters) skip the solver, queue order only
 
     void setSecret(const std::string& phrase); //set/normalize phrase
+    void setNormalizedSecret(std::string secret); //already normalizePhrase(fold(phrase)) output, e.g. a corpus normalized on load;
+                                                  //other bytes assert in debug builds and are dropped otherwise
     std::string maskedPhrase() const; //return phrase with "_" for hidden letters
+    std::string maskedWindow(size_t offset, size_t length) const; //part of maskedPhrase(), cost = length
+    size_t phraseLength() const { return secret_.size(); }
+    bool largeSecret() const { return secret_.size() > LARGE_SECRET; }
 
     int limbsRemaining() const { return limbsRemaining_; }
     int maxGuesses() const { return MAX_GUESSES; }
@@ -98,25 +118,41 @@ public:
     bool isGameOver() const { return gameOver_; }
     bool playerWon() const { return playerWon_; }
 
-    TurnInfo nextTurn();          // one AI guess
     void loseLimb(int limbIndex); // user chooses which limb to sacrifice
 
     std::vector<bool> lostLimbs() const; //true if limb i is lost
     std::string limbName(int index) const; //limb index for log/UI
     std::vector<std::pair<int, std::string>> availableLimbs() const; //list of limbs for menu (readable)
 
-private:
-    std::string secret_; //secret phrase in uppercase (letter and spaces)
-    std::vector<bool> revealed_; //reveal flag per letter
+    GuessState guessState() const; //masked phrase + guessed letters for strategies
+    void setLetterModel(std::shared_ptr<LetterModel> model) { letterModel_ = std::move(model); } //past secrets reorder the pack/order.txt/english queue
+    void setLanguage(std::shared_ptr<const LanguagePack> pack) { language_ = std::move(pack); } //folding + queue order, next setSecret on
+    bool setLetterOrder(const std::string& order); //default queue order (e.g. tools/letterprofile), missing letters appended
+    bool loadLetterOrder(const std::string& path); //first line of a text file, false if missing/invalid
+    std::string letterOrder() const; //the 26-letter default order in use
+    const SolveStats& solveStats() const { return solveStats_; } //per-turn solve times, deadline hits
+    void resetSolveStats() { solveStats_ = SolveStats(); }
+
+protected:
+    TurnInfo playGuess(char g); //apply the ai letter (0 = out of letters) and update game state
+    bool useLetter(char c); //mark c guessed, false if not a fresh letter
+    char queueLetter(); //pop next unused letter from queue
+
+    std::string secret_; //secret phrase in uppercase (letter and spaces), a letter is shown once guessed
+    size_t letterCount_[26] = {}; //occurrences per letter, a guess is O(1) whatever the length
+    size_t hiddenCount_ = 0; //letters not revealed yet
     bool gameOver_ = false;
     bool playerWon_ = false;
 
-    static const int MAX_GUESSES = 18; //number of tries for AI
     int guessesUsed_ = 0;
     int limbsRemaining_ = TOTAL_LIMBS;
 
     LetterQueue guessQueue_; //order of letters to guess
     bool guessedHash_[26]; //hash set (letters used already)
+    SolveStats solveStats_; //kept across games
+    std::shared_ptr<LetterModel> letterModel_; //null = fixed order (pack, order.txt or english)
+    std::shared_ptr<const LanguagePack> language_; //null = english, ascii letters only
+    std::string letterOrder_; //empty = built-in english order
 
     LimbList limbList_; //list limbs to lose
     MoveStack moveStack_; //stack of lost limbs
@@ -124,7 +160,72 @@ private:
     BodyGraph bodyGraph_; //graph of body anatomy (connection of limbs)
 
     bool allRevealed() const; //is phrase fully guessed?
-    char pickNextLetter(); //pop next letter from queue
+};
+
+//plain frequency queue ai, the engine skips building a GuessState for it
+struct QueueStrategy {
+    char pick(const GuessState&) { return 0; }
+};
+
+//engine with the strategy as a template parameter, pick() is a direct (inlinable) call
+//use concrete final strategies here, GameEngine below is the runtime-switchable version
+template <typename Strategy>
+class BasicGameEngine : public GameEngineBase {
+public:
+    template <typename... Args>
+    explicit BasicGameEngine(Args&&... args) : strategy_(std::forward<Args>(args)...) {}
+
+    Strategy& strategy() { return strategy_; }
+
+    TurnInfo nextTurn() { return nextTurn(std::chrono::steady_clock::time_point::max()); } // one AI guess (no time limit)
+
+    TurnInfo nextTurn(std::chrono::steady_clock::time_point deadline) { // one AI guess, answered by deadline
+        if (gameOver_) {
+            TurnInfo info;
+            info.gameOver = true;
+            return info;
+        }
+        return playGuess(pickNextLetter(deadline));
+    }
+
+private:
+    // strategy pick if it has one, otherwise dequeue next unused letter from queue
+    char pickNextLetter(std::chrono::steady_clock::time_point deadline) {
+        if constexpr (!std::is_same<Strategy, QueueStrategy>::value) {
+            if (largeSecret()){
+                return queueLetter(); //no per-turn copy of a multi-MB masked phrase
+            }
+            auto start = std::chrono::steady_clock::now();
+            GuessState st = guessState();
+            st.deadline = deadline;
+            char c = strategy_.pick(st);
+            auto end = std::chrono::steady_clock::now();
+            bool usable = useLetter(c);
+            solveStats_.record(std::chrono::duration<double, std::milli>(end - start).count(),
+                               end > deadline, !usable);
+            if (usable){
+                return c;
+            }
+        }
+        return queueLetter();
+    }
+
+    Strategy strategy_;
+};
+
+//type-erased strategy so the GUI can swap ai at runtime (one virtual call per turn)
+class DynamicStrategy {
+public:
+    char pick(const GuessState& state) { return impl_ ? impl_->pick(state) : 0; }
+    std::unique_ptr<GuessStrategy> impl_; //null = queue only
+};
+
+//runtime-configured engine used by the GUI
+class GameEngine : public BasicGameEngine<DynamicStrategy> {
+public:
+    void setStrategy(std::unique_ptr<GuessStrategy> ai) { strategy().impl_ = std::move(ai); } //smarter ai (null = queue only)
+    bool loadDecisionTree(const std::string& path); //play by walking an offline tree, current strategy becomes its fallback
+    bool loadNGramModel(const std::string& path); //letter model for words outside the dictionary, used after the current strategy
 };
 
 #endif // GAMEENGINE_H
@@ -0,0 +1,142 @@
+#include "language.h"
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+//bytes in the utf-8 sequence started by lead byte c
+static size_t utf8Length(unsigned char c) {
+    if (c < 0x80){
+        return 1;
+    }
+    if ((c & 0xE0) == 0xC0){
+        return 2;
+    }
+    if ((c & 0xF0) == 0xE0){
+        return 3;
+    }
+    if ((c & 0xF8) == 0xF0){
+        return 4;
+    }
+    return 1; //stray continuation byte
+}
+
+bool LanguagePack::load(const std::string& dir) {
+    std::ifstream in(dir + "/pack.txt");
+    if (!in){
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string key, a, b;
+        if (!(fields >> key) || key[0] == '#'){
+            continue;
+        }
+        if (key == "name") {
+            std::getline(fields >> std::ws, name_);
+        } else if (key == "order" && fields >> a) {
+            order_.clear();
+            for (char c : a) {
+                c = std::toupper((unsigned char)c);
+                if (c >= 'A' && c <= 'Z' && order_.find(c) == std::string::npos){
+                    order_.push_back(c);
+                }
+            }
+        } else if (key == "fold" && fields >> a >> b && (unsigned char)a[0] >= 0x80) {
+            char target = std::toupper((unsigned char)b[0]);
+            if (target >= 'A' && target <= 'Z'){
+                folds_[a] = target;
+            }
+        }
+    }
+    if (order_.empty()){
+        return false;
+    }
+
+    auto dawg = std::make_shared<Dawg>();
+    if (dawg->map(dir + "/words.dawg")){ //optional, queue only without it
+        dawg_ = dawg;
+    }
+    return true;
+}
+
+std::string LanguagePack::fold(const std::string& phrase) const {
+    if (folds_.empty()){
+        return phrase;
+    }
+    std::string out;
+    out.reserve(phrase.size());
+    for (size_t i = 0; i < phrase.size();) {
+        size_t n = utf8Length((unsigned char)phrase[i]);
+        if (n > 1) {
+            auto it = folds_.find(phrase.substr(i, n));
+            if (it != folds_.end()) {
+                out.push_back(it->second);
+                i += n;
+                continue;
+            }
+        }
+        out.append(phrase, i, n);
+        i += n;
+    }
+    return out;
+}
+
+void LanguageRegistry::addPack(const std::string& code, const std::string& dir) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& e = packs_[code];
+    if (e.dir != dir) {
+        e = Entry();
+        e.dir = dir;
+    }
+}
+
+size_t LanguageRegistry::addDirectory(const std::string& root) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    size_t found = 0;
+    for (fs::directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+        if (fs::exists(it->path() / "pack.txt")) {
+            addPack(it->path().filename().string(), it->path().string());
+            ++found;
+        }
+    }
+    return found;
+}
+
+std::vector<std::string> LanguageRegistry::codes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> out;
+    for (const auto& p : packs_){
+        out.push_back(p.first);
+    }
+    return out;
+}
+
+std::shared_ptr<const LanguagePack> LanguageRegistry::get(const std::string& code) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = packs_.find(code);
+    if (it == packs_.end() || it->second.failed){
+        return nullptr;
+    }
+    Entry& e = it->second;
+    if (!e.pack) { //first use
+        auto pack = std::make_shared<LanguagePack>();
+        if (!pack->load(e.dir)) {
+            e.failed = true;
+            return nullptr;
+        }
+        e.pack = pack;
+    }
+    return e.pack;
+}
+
+size_t LanguageRegistry::loadedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t n = 0;
+    for (const auto& p : packs_){
+        n += p.second.pack != nullptr;
+    }
+    return n;
+}
@@ -0,0 +1,53 @@
+#ifndef LANGUAGE_H
+#define LANGUAGE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "dawg.h"
+
+//one language: letter order, accented letters folded onto A-Z, and its word graph
+//a pack is a directory holding pack.txt and (optionally) words.dawg from tools/makedawg
+//pack.txt lines: "name Español", "order EAOSRNIDLCTUMPBGVYQHFZJXKW", "fold Ñ N"
+class LanguagePack {
+public:
+    bool load(const std::string& dir); //reads pack.txt, maps words.dawg in place
+
+    const std::string& name() const { return name_; }
+    const std::string& order() const { return order_; } //queue order, letters outside the alphabet never asked
+    std::shared_ptr<const Dawg> dictionary() const { return dawg_; } //null if the pack has none
+
+    //replaces the pack's accented letters (utf-8) by their A-Z letter, other bytes are kept
+    std::string fold(const std::string& phrase) const;
+
+private:
+    std::string name_;
+    std::string order_;
+    std::map<std::string, char> folds_; //utf-8 sequence -> letter
+    std::shared_ptr<Dawg> dawg_;
+};
+
+//known packs by code ("en", "es"...), a pack is read the first time it is asked for and then kept,
+//so switching back and forth costs a map lookup; safe to share between engines/threads
+class LanguageRegistry {
+public:
+    void addPack(const std::string& code, const std::string& dir); //nothing is read yet
+    size_t addDirectory(const std::string& root); //every <root>/<code>/pack.txt, returns how many
+
+    std::vector<std::string> codes() const;
+    std::shared_ptr<const LanguagePack> get(const std::string& code); //null if unknown or broken
+    size_t loadedCount() const;
+
+private:
+    struct Entry {
+        std::string dir;
+        std::shared_ptr<const LanguagePack> pack; //null until first use
+        bool failed = false;
+    };
+    mutable std::mutex mutex_;
+    std::map<std::string, Entry> packs_;
+};
+
+#endif // LANGUAGE_H
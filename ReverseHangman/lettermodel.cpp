@@ -0,0 +1,60 @@
+#include "lettermodel.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+static const char MODEL_MAGIC[4] = {'R', 'H', 'L', 'M'};
+
+//english letter frequencies in percent, most frequent first: the prior of the letter at each rank of
+//the base order, so the base order's shape is kept whatever letters it ranks
+static const double RANK_PRIOR[26] = {
+    12.7, 9.1, 8.2, 7.5, 7.0, 6.7, 6.3, 6.1, 6.0, 4.3, 4.0, 2.8, 2.8,
+    2.4, 2.4, 2.2, 2.0, 2.0, 1.9, 1.5, 0.98, 0.77, 0.15, 0.15, 0.095, 0.074
+};
+
+void LetterModel::observe(const std::string& phrase) {
+    for (char c : phrase) {
+        if (c >= 'A' && c <= 'Z') {
+            ++counts_[c - 'A'];
+            ++total_;
+        }
+    }
+}
+
+std::string LetterModel::order(const std::string& base) const {
+    double score[26] = {};
+    std::string out;
+    for (char c : base) {
+        if (c >= 'A' && c <= 'Z' && out.find(c) == std::string::npos && out.size() < 26) {
+            score[c - 'A'] = counts_[c - 'A'] + PRIOR_LETTERS * RANK_PRIOR[out.size()] / 100.0;
+            out.push_back(c);
+        }
+    }
+    std::stable_sort(out.begin(), out.end(), [&](char a, char b) { //ties keep the base order
+        return score[a - 'A'] > score[b - 'A'];
+    });
+    return out;
+}
+
+bool LetterModel::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[4];
+    uint32_t counts[26];
+    if (!in.read(magic, 4) || std::memcmp(magic, MODEL_MAGIC, 4) != 0
+        || !in.read(reinterpret_cast<char*>(counts), sizeof(counts))){
+        return false;
+    }
+    std::memcpy(counts_, counts, sizeof(counts));
+    total_ = 0;
+    for (uint32_t n : counts_){
+        total_ += n;
+    }
+    return true;
+}
+
+bool LetterModel::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    out.write(MODEL_MAGIC, 4);
+    out.write(reinterpret_cast<const char*>(counts_), sizeof(counts_));
+    return bool(out);
+}
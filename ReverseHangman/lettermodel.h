@@ -0,0 +1,26 @@
+#ifndef LETTERMODEL_H
+#define LETTERMODEL_H
+
+#include <cstdint>
+#include <string>
+
+//letter counts of past secrets, reorders the ai guess queue toward what this player uses
+class LetterModel {
+public:
+    static const int PRIOR_LETTERS = 200; //base order prior weighs as much as this many letters seen
+
+    void observe(const std::string& phrase); //O(length), phrase already normalized
+    //base's letters, most likely first: with no history exactly base (e.g. order.txt or a language pack's
+    //order), letters this player uses more than base expects move up as history builds
+    std::string order(const std::string& base = "ETAOINSHRDLUCMWFGYPBVKJXQZ") const;
+    uint64_t lettersSeen() const { return total_; }
+
+    bool load(const std::string& path); //108 byte file
+    bool save(const std::string& path) const;
+
+private:
+    uint32_t counts_[26] = {};
+    uint64_t total_ = 0;
+};
+
+#endif // LETTERMODEL_H
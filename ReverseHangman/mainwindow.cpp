@@ -1,6 +1,11 @@
 #include "mainwindow.h"
 #include "bodywidget.h"
 #include "bodyviewdialog.h"
+#include "anytime.h"
+#include "bitmapindex.h"
+#include "dawg.h"
+#include "openingbook.h"
+#include "phrasesolver.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
@@ -9,6 +14,10 @@
 #include <QInputDialog>
 #include <QMessageBox>
 #include <QKeyEvent>
+#include <QScrollBar>
+#include <QCoreApplication>
+#include <QDir>
+#include <QStandardPaths>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -31,9 +40,65 @@ MainWindow::MainWindow(QWidget *parent)
         return;
     }
 
-    engine_.setSecret(phrase.toStdString());
+    // smarter ai if a word list ships next to the exe (words.txt), queue order otherwise
+    QString appDir = QCoreApplication::applicationDirPath();
+    QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dataDir);
+    auto dict = std::make_shared<Dictionary>();
+    if (dict->loadFromFile((appDir + "/words.txt").toStdString())) {
+        bool multiWord = phrase.trimmed().contains(' ');
+        std::unique_ptr<GuessStrategy> ai;
+        if (multiWord) { //several words: solve them jointly
+            auto bigrams = std::make_shared<WordBigramModel>();
+            bigrams->loadFromFile((appDir + "/bigrams.txt").toStdString()); //optional
+            ai = std::make_unique<PhraseStrategy>(dict, bigrams);
+        } else {
+            auto entropy = std::make_unique<EntropyStrategy>(dict);
+            auto index = std::make_shared<BitmapIndex>();
+            index->build(*dict); //candidate sets by bitmap ANDs
+            entropy->setIndex(index);
+            auto store = std::make_shared<DecisionStore>();
+            if (store->open((dataDir + "/decisions.bin").toStdString(), dict->fingerprint())) { //decisions of earlier sessions
+                entropy->cache()->setStore(store);
+            }
+            ai = std::move(entropy);
+        }
+        auto book = std::make_shared<OpeningBook>();
+        if (book->load((appDir + "/openings.bin").toStdString())) { //first turns are a lookup
+            ai = std::make_unique<OpeningBookStrategy>(book, std::move(ai));
+        }
+        engine_.setStrategy(std::make_unique<AnytimeStrategy>(std::move(ai))); //never blocks past the turn deadline
+        if (!multiWord) {
+            engine_.loadDecisionTree((appDir + "/tree.bin").toStdString()); //optional offline tree, O(1) turns
+        }
+    }
+    else {
+        auto dawg = std::make_shared<Dawg>();
+        if (dawg->load((appDir + "/words.dawg").toStdString())) { //compact word graph (tools/makedawg), wasm builds ship this instead
+            engine_.setStrategy(std::make_unique<AnytimeStrategy>(std::make_unique<DawgStrategy>(dawg)));
+        }
+    }
+
+    engine_.loadNGramModel((appDir + "/ngram.bin").toStdString()); //names/slang the dictionary misses
+    engine_.loadLetterOrder((appDir + "/order.txt").toStdString()); //corpus-derived queue order (tools/letterprofile)
 
-    phraseLabel_->setText(QString::fromStdString(engine_.maskedPhrase()));
+    // learned letter order from this player's earlier phrases
+    std::string historyPath = (dataDir + "/history.bin").toStdString();
+    auto history = std::make_shared<LetterModel>();
+    history->load(historyPath); //first run: english order
+    engine_.setLetterModel(history);
+
+    engine_.setSecret(phrase.toStdString());
+    history->save(historyPath);
+
+    if (engine_.largeSecret()) { //book-length phrase: scroll through a window of it
+        phraseScroll_->setRange(0, int(engine_.phraseLength()) - PHRASE_WINDOW);
+        phraseScroll_->setPageStep(PHRASE_WINDOW);
+        phraseScroll_->setSingleStep(PHRASE_WINDOW / 4);
+        phraseScroll_->show();
+        phraseLabel_->setWordWrap(true);
+    }
+    showPhrase();
     limbLabel_->setText(
         QString("Limbs remaining: %1").arg(GameEngine::TOTAL_LIMBS)
         );
@@ -52,6 +117,11 @@ void MainWindow::setupUi()
     f.setPointSize(20);
     phraseLabel_->setFont(f);
 
+    phraseScroll_ = new QScrollBar(Qt::Horizontal);
+    phraseScroll_->hide();
+    connect(phraseScroll_, &QScrollBar::valueChanged,
+            this, &MainWindow::showPhrase);
+
     limbLabel_ = new QLabel("Limbs remaining:");
     guessLabel_ = new QLabel("Ready.");
 
@@ -79,6 +149,7 @@ void MainWindow::setupUi()
             this, &MainWindow::onLimbClicked);
 
     mainLayout->addWidget(phraseLabel_);
+    mainLayout->addWidget(phraseScroll_);
     mainLayout->addWidget(limbLabel_);
     mainLayout->addWidget(guessLabel_);
     mainLayout->addLayout(topButtons);
@@ -132,7 +203,8 @@ void MainWindow::onNextTurn()
         return;
     }
 
-    TurnInfo info = engine_.nextTurn(); // game engine performs guess
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TURN_DEADLINE_MS);
+    TurnInfo info = engine_.nextTurn(deadline); // game engine performs guess
     lastTurn_ = info;
 
     if (info.hit && !info.gameOver) { //show guess outcomes, choose sacrifice
@@ -213,9 +285,7 @@ void MainWindow::onLimbClicked(int index)
 // sync widgets with engine status
 void MainWindow::updateUiFromGame(const TurnInfo &info, bool afterLimbChoice)
 {
-    phraseLabel_->setText(
-        QString::fromStdString(engine_.maskedPhrase())
-        );
+    showPhrase();
 
     auto lost = engine_.lostLimbs();
     int remaining = GameEngine::TOTAL_LIMBS;
@@ -245,6 +315,23 @@ void MainWindow::updateUiFromGame(const TurnInfo &info, bool afterLimbChoice)
     logEdit_->append(logLine);
 }
 
+// whole masked phrase, or the scrolled-to window of a large secret
+void MainWindow::showPhrase()
+{
+    if (!engine_.largeSecret()) {
+        phraseLabel_->setText(QString::fromStdString(engine_.maskedPhrase()));
+        return;
+    }
+    size_t offset = (size_t)phraseScroll_->value();
+    phraseLabel_->setText(
+        QString("%1 (letters %2-%3 of %4)")
+            .arg(QString::fromStdString(engine_.maskedWindow(offset, PHRASE_WINDOW)))
+            .arg(offset + 1)
+            .arg(std::min(offset + PHRASE_WINDOW, engine_.phraseLength()))
+            .arg(engine_.phraseLength())
+        );
+}
+
 //opens dialof for all limbs statuses
 void MainWindow::onViewBody()
 {
@@ -6,6 +6,7 @@
 
 class QLabel;
 class QPushButton;
+class QScrollBar;
 class QTextEdit;
 class BodyWidget;
 
@@ -29,11 +30,16 @@ private:
     void updateUiFromGame(const TurnInfo& info, bool afterLimbChoice);
     void enterLimbSelectionMode();
     void exitLimbSelectionMode();
+    void showPhrase(); //masked phrase, only the scrolled-to window for large secrets
+
+    static constexpr int TURN_DEADLINE_MS = 100; //ai must answer within this, keeps the ui responsive
+    static constexpr int PHRASE_WINDOW = 240; //letters shown at once for large secrets
 
     GameEngine engine_; //main game rules
 
     //ui controls
     QLabel* phraseLabel_;
+    QScrollBar* phraseScroll_; //only shown for large secrets
     QLabel* limbLabel_;
     QLabel* guessLabel_;
     QTextEdit* logEdit_;
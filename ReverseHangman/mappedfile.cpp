@@ -0,0 +1,154 @@
+#include "mappedfile.h"
+#include <algorithm>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE){
+        return false;
+    }
+    LARGE_INTEGER len;
+    if (!GetFileSizeEx(file, &len) || len.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping){
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+    file_ = file;
+    mapping_ = mapping;
+    data_ = view;
+    size_ = (size_t)len.QuadPart;
+    return true;
+}
+
+bool MappedFile::openWritable(const std::string& path, size_t minSize) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              nullptr, minSize ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE){
+        return false;
+    }
+    LARGE_INTEGER len;
+    if (!GetFileSizeEx(file, &len) || (minSize == 0 && len.QuadPart == 0)) {
+        CloseHandle(file);
+        return false;
+    }
+    size_t size = (std::max)((size_t)len.QuadPart, minSize); //parenthesized: windows.h max macro
+    //mapping a larger size than the file grows it
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+                                        DWORD((uint64_t)size >> 32), DWORD(size & 0xFFFFFFFFu), nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping){
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+    file_ = file;
+    mapping_ = mapping;
+    data_ = view;
+    size_ = size;
+    writable_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_){
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_){
+        CloseHandle(mapping_);
+    }
+    if (file_){
+        CloseHandle(file_);
+    }
+    data_ = mapping_ = file_ = nullptr;
+    size_ = 0;
+    writable_ = false;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0){
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); //mapping keeps the file alive
+    if (view == MAP_FAILED){
+        return false;
+    }
+    data_ = view;
+    size_ = (size_t)st.st_size;
+    return true;
+}
+
+bool MappedFile::openWritable(const std::string& path, size_t minSize) {
+    close();
+    int fd = ::open(path.c_str(), minSize ? O_RDWR | O_CREAT : O_RDWR, 0644);
+    if (fd < 0){
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (minSize == 0 && st.st_size == 0)) {
+        ::close(fd);
+        return false;
+    }
+    size_t size = std::max((size_t)st.st_size, minSize);
+    if ((size_t)st.st_size < size && ftruncate(fd, (off_t)size) != 0) { //new space reads as zeros
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED){
+        return false;
+    }
+    data_ = view;
+    size_ = size;
+    writable_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_){
+        munmap(data_, size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    writable_ = false;
+}
+
+#endif
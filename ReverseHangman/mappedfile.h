@@ -0,0 +1,35 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+//memory mapping of a whole file (posix mmap / win32 file mapping), read-only unless opened writable
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path); //false if missing or empty
+    bool openWritable(const std::string& path, size_t minSize); //created/grown to minSize, writes reach the file
+                                                                //minSize 0: existing non-empty file only, as is
+    void close();
+
+    bool isOpen() const { return data_ != nullptr; }
+    const char* data() const { return static_cast<const char*>(data_); }
+    char* writableData() { return writable_ ? static_cast<char*>(data_) : nullptr; }
+    size_t size() const { return size_; }
+
+private:
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    bool writable_ = false;
+#ifdef _WIN32
+    void* file_ = nullptr;    //HANDLE
+    void* mapping_ = nullptr; //HANDLE
+#endif
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,123 @@
+#include "ngrammodel.h"
+#include "normalize.h"
+#include <cstring>
+#include <fstream>
+
+static const char NGRAM_MAGIC[4] = {'R', 'H', 'N', 'G'};
+static const size_t HEADER_SIZE = 8; //magic + symbol count
+static const int EDGE = 0;
+static const int HIDDEN = NGramModel::SYMBOLS - 1;
+
+int NGramModel::symbolOf(char c) {
+    if (c >= 'A' && c <= 'Z'){
+        return 1 + (c - 'A');
+    }
+    if (c == '_'){
+        return HIDDEN;
+    }
+    return EDGE; //space, start/end of phrase
+}
+
+bool NGramModel::load(const std::string& path) {
+    table_ = nullptr;
+    if (!file_.open(path)){
+        return false;
+    }
+    uint32_t symbols = 0;
+    if (file_.size() != HEADER_SIZE + TABLE_SIZE || std::memcmp(file_.data(), NGRAM_MAGIC, 4) != 0){
+        file_.close();
+        return false;
+    }
+    std::memcpy(&symbols, file_.data() + 4, sizeof(symbols));
+    if (symbols != SYMBOLS) {
+        file_.close();
+        return false;
+    }
+    table_ = reinterpret_cast<const uint8_t*>(file_.data() + HEADER_SIZE);
+    return true;
+}
+
+void NGramModel::score(const std::string& masked, uint32_t scores[26]) const {
+    for (int c = 0; c < 26; ++c){
+        scores[c] = 0;
+    }
+    if (!table_){
+        return;
+    }
+    size_t n = masked.size();
+    for (size_t i = 0; i < n; ++i) {
+        if (masked[i] != '_'){
+            continue;
+        }
+        int l = i > 0 ? symbolOf(masked[i - 1]) : EDGE;
+        int r = i + 1 < n ? symbolOf(masked[i + 1]) : EDGE;
+        const uint8_t* row = table_ + (l * SYMBOLS + r) * 26;
+        for (int c = 0; c < 26; ++c){ //flat add of one row, vectorizes
+            scores[c] += row[c];
+        }
+    }
+}
+
+bool NGramModel::build(std::istream& corpus, const std::string& outPath) {
+    std::vector<double> counts(TABLE_SIZE, 0.0);
+    std::string line;
+    while (std::getline(corpus, line)) {
+        std::string text = normalizePhrase(line); //same cleanup as the game secret
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (text[i] == ' '){
+                continue;
+            }
+            int l = i > 0 ? symbolOf(text[i - 1]) : EDGE;
+            int r = i + 1 < text.size() ? symbolOf(text[i + 1]) : EDGE;
+            int c = text[i] - 'A';
+            //neighbours may still be hidden when the model is asked, count those contexts too
+            counts[(l * SYMBOLS + r) * 26 + c] += 1.0;
+            counts[(HIDDEN * SYMBOLS + r) * 26 + c] += 1.0;
+            counts[(l * SYMBOLS + HIDDEN) * 26 + c] += 1.0;
+            counts[(HIDDEN * SYMBOLS + HIDDEN) * 26 + c] += 1.0;
+        }
+    }
+
+    std::vector<uint8_t> table(TABLE_SIZE, 0);
+    for (size_t ctx = 0; ctx < (size_t)SYMBOLS * SYMBOLS; ++ctx) {
+        double total = 0.0;
+        for (int c = 0; c < 26; ++c){
+            total += counts[ctx * 26 + c] + 0.5; //light smoothing, unseen letters stay possible
+        }
+        for (int c = 0; c < 26; ++c) {
+            double p = (counts[ctx * 26 + c] + 0.5) / total;
+            int q = int(p * 255.0 + 0.5);
+            table[ctx * 26 + c] = (uint8_t)(q < 1 ? 1 : (q > 255 ? 255 : q));
+        }
+    }
+
+    std::ofstream out(outPath, std::ios::binary);
+    uint32_t symbols = SYMBOLS;
+    out.write(NGRAM_MAGIC, 4);
+    out.write(reinterpret_cast<const char*>(&symbols), sizeof(symbols));
+    out.write(reinterpret_cast<const char*>(table.data()), table.size());
+    return bool(out);
+}
+
+NGramStrategy::NGramStrategy(std::shared_ptr<const NGramModel> model)
+    : model_(std::move(model))
+{
+}
+
+char NGramStrategy::pick(const GuessState& state) {
+    if (!model_ || !model_->isLoaded()){
+        return 0;
+    }
+    uint32_t scores[26];
+    model_->score(state.masked, scores);
+    int best = -1;
+    for (int c = 0; c < 26; ++c) {
+        if (state.guessed & (1u << c)){
+            continue;
+        }
+        if (scores[c] > 0 && (best < 0 || scores[c] > scores[best])){
+            best = c;
+        }
+    }
+    return best < 0 ? 0 : char('A' + best);
+}
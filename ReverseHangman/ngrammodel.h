@@ -0,0 +1,46 @@
+#ifndef NGRAMMODEL_H
+#define NGRAMMODEL_H
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "mappedfile.h"
+#include "solver.h"
+
+//letter model for hidden positions conditioned on the left/right neighbour in maskedPhrase()
+//neighbour symbol: 0 = word edge, 1-26 = revealed letter, 27 = hidden
+//table[left][right][letter] = P(letter | left, right) quantized to 0-255, memory-mapped from disk
+class NGramModel {
+public:
+    static const int SYMBOLS = 28;
+    static const size_t TABLE_SIZE = SYMBOLS * SYMBOLS * 26;
+
+    bool load(const std::string& path); //maps the file, table stays on disk pages
+    bool isLoaded() const { return table_ != nullptr; }
+
+    //sum of quantized probabilities per letter over every hidden position
+    void score(const std::string& masked, uint32_t scores[26]) const;
+
+    //offline: count neighbours in a corpus (one phrase per line) and write a model file
+    static bool build(std::istream& corpus, const std::string& outPath);
+
+private:
+    static int symbolOf(char c);
+
+    MappedFile file_;
+    const uint8_t* table_ = nullptr;
+};
+
+//best unguessed letter by n-gram score, for words no dictionary knows
+class NGramStrategy final : public GuessStrategy {
+public:
+    explicit NGramStrategy(std::shared_ptr<const NGramModel> model);
+    char pick(const GuessState& state) override;
+
+private:
+    std::shared_ptr<const NGramModel> model_;
+};
+
+#endif // NGRAMMODEL_H
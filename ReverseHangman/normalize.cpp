@@ -0,0 +1,204 @@
+#include "normalize.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NORMALIZE_SSE2 1
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define NORMALIZE_WASM 1
+#endif
+
+//latin-1 supplement + latin extended-a/b folded to A-Z, "" = not a letter (U+00C0..U+024F)
+static const unsigned FOLD_FIRST = 0xC0;
+static const unsigned FOLD_LAST = 0x24F;
+static const char LATIN_FOLD[FOLD_LAST - FOLD_FIRST + 1][3] = {
+    "A", "A", "A", "A", "A", "A", "AE", "C", //U+00C0
+    "E", "E", "E", "E", "I", "I", "I", "I", //U+00C8
+    "D", "N", "O", "O", "O", "O", "O", "", //U+00D0
+    "O", "U", "U", "U", "U", "Y", "TH", "SS", //U+00D8
+    "A", "A", "A", "A", "A", "A", "AE", "C", //U+00E0
+    "E", "E", "E", "E", "I", "I", "I", "I", //U+00E8
+    "D", "N", "O", "O", "O", "O", "O", "", //U+00F0
+    "O", "U", "U", "U", "U", "Y", "TH", "Y", //U+00F8
+    "A", "A", "A", "A", "A", "A", "C", "C", //U+0100
+    "C", "C", "C", "C", "C", "C", "D", "D", //U+0108
+    "D", "D", "E", "E", "E", "E", "E", "E", //U+0110
+    "E", "E", "E", "E", "G", "G", "G", "G", //U+0118
+    "G", "G", "G", "G", "H", "H", "H", "H", //U+0120
+    "I", "I", "I", "I", "I", "I", "I", "I", //U+0128
+    "I", "I", "IJ", "IJ", "J", "J", "K", "K", //U+0130
+    "K", "L", "L", "L", "L", "L", "L", "L", //U+0138
+    "L", "L", "L", "N", "N", "N", "N", "N", //U+0140
+    "N", "N", "NG", "NG", "O", "O", "O", "O", //U+0148
+    "O", "O", "OE", "OE", "R", "R", "R", "R", //U+0150
+    "R", "R", "S", "S", "S", "S", "S", "S", //U+0158
+    "S", "S", "T", "T", "T", "T", "T", "T", //U+0160
+    "U", "U", "U", "U", "U", "U", "U", "U", //U+0168
+    "U", "U", "U", "U", "W", "W", "Y", "Y", //U+0170
+    "Y", "Z", "Z", "Z", "Z", "Z", "Z", "S", //U+0178
+    "", "", "", "", "", "", "", "", //U+0180
+    "", "", "", "", "", "", "", "", //U+0188
+    "", "", "", "", "", "", "", "", //U+0190
+    "", "", "", "", "", "", "", "", //U+0198
+    "O", "O", "", "", "", "", "", "", //U+01A0
+    "", "", "", "", "", "", "", "U", //U+01A8
+    "U", "", "", "", "", "", "", "", //U+01B0
+    "", "", "", "", "", "", "", "", //U+01B8
+    "", "", "", "", "DZ", "DZ", "DZ", "LJ", //U+01C0
+    "LJ", "LJ", "NJ", "NJ", "NJ", "A", "A", "I", //U+01C8
+    "I", "O", "O", "U", "U", "U", "U", "U", //U+01D0
+    "U", "U", "U", "U", "U", "", "A", "A", //U+01D8
+    "A", "A", "", "", "", "", "G", "G", //U+01E0
+    "K", "K", "O", "O", "O", "O", "", "", //U+01E8
+    "J", "DZ", "DZ", "DZ", "G", "G", "", "", //U+01F0
+    "N", "N", "A", "A", "", "", "", "", //U+01F8
+    "A", "A", "A", "A", "E", "E", "E", "E", //U+0200
+    "I", "I", "I", "I", "O", "O", "O", "O", //U+0208
+    "R", "R", "R", "R", "U", "U", "U", "U", //U+0210
+    "S", "S", "T", "T", "", "", "H", "H", //U+0218
+    "", "", "", "", "", "", "A", "A", //U+0220
+    "E", "E", "O", "O", "O", "O", "O", "O", //U+0228
+    "O", "O", "Y", "Y", "", "", "", "", //U+0230
+    "", "", "", "", "", "", "", "", //U+0238
+    "", "", "", "", "", "", "", "", //U+0240
+    "", "", "", "", "", "", "", "", //U+0248
+};
+
+//copies the kept bytes of a 16 byte block, bit i of keep = byte i stays
+static inline size_t compact16(const char* block, unsigned keep, char* out) {
+    size_t k = 0;
+    for (; keep; keep &= keep - 1){
+        out[k++] = block[__builtin_ctz(keep)];
+    }
+    return k;
+}
+
+//ascii part up to the first byte >= 0x80: letter -> uppercase, space -> space, rest dropped
+//returns bytes consumed, adds to k what was written
+static size_t asciiRun(const char* in, size_t n, char* out, size_t& k) {
+    size_t i = 0;
+#if defined(NORMALIZE_SSE2)
+    const __m128i caseBit = _mm_set1_epi8(char(0xDF));
+    const __m128i beforeA = _mm_set1_epi8('A' - 1);
+    const __m128i afterZ = _mm_set1_epi8('Z' + 1);
+    const __m128i space = _mm_set1_epi8(' ');
+    for (; i + 16 <= n; i += 16) {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        if (_mm_movemask_epi8(c)){
+            break; //utf-8 inside, the scalar loop finds where
+        }
+        __m128i u = _mm_and_si128(c, caseBit);
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(u, beforeA), _mm_cmplt_epi8(u, afterZ));
+        __m128i blank = _mm_cmpeq_epi8(c, space);
+        __m128i v = _mm_or_si128(_mm_and_si128(letter, u), _mm_and_si128(blank, space));
+        unsigned keep = (unsigned)_mm_movemask_epi8(_mm_or_si128(letter, blank));
+        if (keep == 0xFFFF) { //plain text block, store as is
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k), v);
+            k += 16;
+        } else {
+            alignas(16) char block[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(block), v);
+            k += compact16(block, keep, out + k);
+        }
+    }
+#elif defined(NORMALIZE_WASM)
+    const v128_t caseBit = wasm_i8x16_splat(char(0xDF));
+    const v128_t beforeA = wasm_i8x16_splat('A' - 1);
+    const v128_t afterZ = wasm_i8x16_splat('Z' + 1);
+    const v128_t space = wasm_i8x16_splat(' ');
+    for (; i + 16 <= n; i += 16) {
+        v128_t c = wasm_v128_load(in + i);
+        if (wasm_i8x16_bitmask(c)){
+            break;
+        }
+        v128_t u = wasm_v128_and(c, caseBit);
+        v128_t letter = wasm_v128_and(wasm_i8x16_gt(u, beforeA), wasm_i8x16_lt(u, afterZ));
+        v128_t blank = wasm_i8x16_eq(c, space);
+        v128_t v = wasm_v128_or(wasm_v128_and(letter, u), wasm_v128_and(blank, space));
+        unsigned keep = wasm_i8x16_bitmask(wasm_v128_or(letter, blank));
+        if (keep == 0xFFFF) {
+            wasm_v128_store(out + k, v);
+            k += 16;
+        } else {
+            alignas(16) char block[16];
+            wasm_v128_store(block, v);
+            k += compact16(block, keep, out + k);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        char c = in[i];
+        if (c & 0x80){
+            break;
+        }
+        char u = char(c & 0xDF); //clears the lowercase bit
+        if (u >= 'A' && u <= 'Z'){
+            out[k++] = u;
+        }
+        else if (c == ' '){
+            out[k++] = ' ';
+        }
+    }
+    return i;
+}
+
+size_t normalizeAscii(const char* in, size_t n, char* out) {
+    size_t i = 0, k = 0;
+    while (i < n) {
+        i += asciiRun(in + i, n - i, out, k);
+        i += i < n; //drop the non-ascii byte
+    }
+    return k;
+}
+
+//code point of the utf-8 sequence at in (len bytes consumed), -1 if malformed
+static long decodeUtf8(const unsigned char* in, size_t n, size_t& len) {
+    unsigned char c = in[0];
+    len = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+    if (len == 1 || len > n){
+        len = 1;
+        return -1; //stray continuation byte or cut sequence
+    }
+    long cp = c & (0x3F >> (len - 1));
+    for (size_t k = 1; k < len; ++k) {
+        if ((in[k] & 0xC0) != 0x80) {
+            len = k;
+            return -1;
+        }
+        cp = (cp << 6) | (in[k] & 0x3F);
+    }
+    return cp;
+}
+
+size_t normalizeText(const char* in, size_t n, char* out) {
+    size_t i = 0, k = 0;
+    while (i < n) {
+        i += asciiRun(in + i, n - i, out, k);
+        if (i >= n){
+            break;
+        }
+        size_t len;
+        long cp = decodeUtf8(reinterpret_cast<const unsigned char*>(in + i), n - i, len);
+        i += len;
+        const char* fold = nullptr;
+        if (cp >= (long)FOLD_FIRST && cp <= (long)FOLD_LAST){
+            fold = LATIN_FOLD[cp - FOLD_FIRST];
+        }
+        else if (cp == 0xA0 || cp == 0x3000){ //no-break and ideographic space
+            out[k++] = ' ';
+        }
+        else if ((cp >= 0xFF21 && cp <= 0xFF3A) || (cp >= 0xFF41 && cp <= 0xFF5A)){ //fullwidth latin
+            out[k++] = char('A' + (cp - (cp >= 0xFF41 ? 0xFF41 : 0xFF21)));
+        }
+        for (; fold && *fold; ++fold){ //at most 2 letters from a 2 byte sequence
+            out[k++] = *fold;
+        }
+    }
+    return k;
+}
+
+std::string normalizePhrase(const std::string& s) {
+    std::string r(s.size(), '\0');
+    r.resize(normalizeText(s.data(), s.size(), &r[0]));
+    return r;
+}
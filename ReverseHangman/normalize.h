@@ -0,0 +1,20 @@
+#ifndef NORMALIZE_H
+#define NORMALIZE_H
+
+#include <cstddef>
+#include <string>
+
+//phrase cleanup shared by the engine and the corpus readers: letters uppercased, spaces kept,
+//everything else dropped; both write at most n bytes to out (no overlap) and return the count
+//ascii runs go 16 bytes per step with sse2/wasm simd, scalar tail and fallback
+
+//ascii letters only, every byte >= 0x80 is dropped
+size_t normalizeAscii(const char* in, size_t n, char* out);
+
+//utf-8: accented latin letters are folded by table (É -> E, ß -> SS, Æ -> AE), fullwidth latin
+//mapped to A-Z, letters of other scripts and malformed bytes dropped
+size_t normalizeText(const char* in, size_t n, char* out);
+
+std::string normalizePhrase(const std::string& s); //normalizeText, one allocation sized to the input
+
+#endif // NORMALIZE_H
@@ -0,0 +1,139 @@
+#include "openingbook.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+
+static const char BOOK_MAGIC[4] = {'R', 'H', 'O', 'B'};
+static const size_t SIDE = OpeningBook::MAX_LEN + 1;
+static const size_t ROWS = SIDE * SIDE * SIDE;
+
+size_t OpeningBook::profileIndex(const std::string& masked) {
+    std::vector<size_t> lens;
+    for (const auto& w : splitWords(masked)){
+        lens.push_back(std::min<size_t>(w.second, MAX_LEN));
+    }
+    std::sort(lens.rbegin(), lens.rend());
+    lens.resize(MAX_WORDS, 0); //pad short phrases with "no word"
+    return (lens[0] * SIDE + lens[1]) * SIDE + lens[2];
+}
+
+const char* OpeningBook::line(const std::string& masked) const {
+    if (table_.empty()){
+        return nullptr;
+    }
+    const char* row = &table_[profileIndex(masked) * depth_];
+    return row[0] ? row : nullptr;
+}
+
+void OpeningBook::build(const Dictionary& dict, int depth) {
+    depth_ = std::max(1, std::min(depth, 26));
+    table_.assign(ROWS * depth_, '\0');
+
+    //fraction of words of each length that contain each letter
+    std::vector<std::array<double, 26>> frac(SIDE);
+    std::vector<size_t> counts(SIDE, 0);
+    for (auto& f : frac){
+        f.fill(0.0);
+    }
+    for (size_t len = 1; len <= 32; ++len) {
+        size_t bucket = std::min<size_t>(len, MAX_LEN);
+        for (const std::string& w : dict.wordsOfLength(len)) {
+            uint32_t seen = 0;
+            for (char c : w){
+                seen |= 1u << (c - 'A');
+            }
+            for (int c = 0; c < 26; ++c){
+                if (seen & (1u << c)){
+                    frac[bucket][c] += 1.0;
+                }
+            }
+            ++counts[bucket];
+        }
+    }
+    for (size_t len = 0; len < SIDE; ++len){
+        for (int c = 0; c < 26; ++c){
+            if (counts[len]){
+                frac[len][c] /= double(counts[len]);
+            }
+        }
+    }
+
+    //each profile plays the letters with the most expected hits over its words
+    const std::string english = "ETAOINSHRDLUCMWFGYPBVKJXQZ"; //tie break
+    for (size_t a = 1; a < SIDE; ++a) {
+        for (size_t b = 0; b <= a; ++b) {
+            for (size_t c = 0; c <= b; ++c) {
+                if (b == 0 && c != 0){
+                    continue;
+                }
+                std::array<double, 26> score{};
+                for (size_t len : {a, b, c}){
+                    for (int k = 0; k < 26 && len; ++k){
+                        score[k] += frac[len][k];
+                    }
+                }
+                std::string order = english;
+                std::stable_sort(order.begin(), order.end(), [&](char x, char y) {
+                    return score[x - 'A'] > score[y - 'A'];
+                });
+                if (score[order[0] - 'A'] <= 0.0){
+                    continue; //no words of these lengths, leave to live search
+                }
+                std::memcpy(&table_[((a * SIDE + b) * SIDE + c) * depth_], order.data(), depth_);
+            }
+        }
+    }
+}
+
+bool OpeningBook::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[4];
+    int32_t depth = 0;
+    if (!in.read(magic, 4) || std::memcmp(magic, BOOK_MAGIC, 4) != 0){
+        return false;
+    }
+    if (!in.read(reinterpret_cast<char*>(&depth), sizeof(depth)) || depth < 1 || depth > 26){
+        return false;
+    }
+    std::vector<char> table(ROWS * depth);
+    if (!in.read(table.data(), table.size())){
+        return false;
+    }
+    depth_ = depth;
+    table_.swap(table);
+    return true;
+}
+
+bool OpeningBook::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    int32_t depth = depth_;
+    out.write(BOOK_MAGIC, 4);
+    out.write(reinterpret_cast<const char*>(&depth), sizeof(depth));
+    out.write(table_.data(), table_.size());
+    return bool(out);
+}
+
+OpeningBookStrategy::OpeningBookStrategy(std::shared_ptr<const OpeningBook> book,
+                                         std::unique_ptr<GuessStrategy> fallback)
+    : book_(std::move(book)), fallback_(std::move(fallback))
+{
+}
+
+char OpeningBookStrategy::pick(const GuessState& state) {
+    int turn = 0;
+    for (uint32_t m = state.guessed; m; m &= m - 1){
+        ++turn;
+    }
+    const char* line = (book_ && turn < book_->depth()) ? book_->line(state.masked) : nullptr;
+    if (line) {
+        uint32_t played = 0; //still on the book line only if exactly its first moves were played
+        for (int i = 0; i < turn; ++i){
+            played |= 1u << (line[i] - 'A');
+        }
+        if (played == state.guessed){
+            return line[turn];
+        }
+    }
+    return fallback_ ? fallback_->pick(state) : 0;
+}
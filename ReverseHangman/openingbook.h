@@ -0,0 +1,43 @@
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "solver.h"
+
+//first few ai guesses per word-length profile (the 3 longest words of the phrase),
+//computed offline by tools/makeopeningbook and loaded at startup
+class OpeningBook {
+public:
+    static const int MAX_WORDS = 3;   //profile = lengths of the 3 longest words
+    static const int MAX_LEN = 16;    //longer words count as 16
+    static const int DEFAULT_DEPTH = 5;
+
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+    void build(const Dictionary& dict, int depth = DEFAULT_DEPTH); //greedy expected hits per profile
+
+    bool empty() const { return table_.empty(); }
+    int depth() const { return depth_; }
+    const char* line(const std::string& masked) const; //depth_ letters for the profile, null if none
+
+private:
+    static size_t profileIndex(const std::string& masked); //index into table (0 = no words)
+
+    int depth_ = 0;
+    std::vector<char> table_; //(MAX_LEN+1)^3 rows of depth_ letters, '\0' = no entry
+};
+
+//plays the book line while the game still follows it, then asks the live strategy
+class OpeningBookStrategy final : public GuessStrategy {
+public:
+    OpeningBookStrategy(std::shared_ptr<const OpeningBook> book, std::unique_ptr<GuessStrategy> fallback);
+    char pick(const GuessState& state) override;
+
+private:
+    std::shared_ptr<const OpeningBook> book_;
+    std::unique_ptr<GuessStrategy> fallback_;
+};
+
+#endif // OPENINGBOOK_H
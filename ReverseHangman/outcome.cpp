@@ -0,0 +1,84 @@
+#include "outcome.h"
+#include "gameengine.h"
+
+uint32_t letterMask(const std::string& phrase) {
+    uint32_t m = 0;
+    for (char c : phrase) {
+        if (c >= 'A' && c <= 'Z'){
+            m |= 1u << (c - 'A');
+        }
+    }
+    return m;
+}
+
+GameOutcome playFixedOrder(uint32_t letters, const std::string& order) {
+    GameOutcome out;
+    int limbs = GameEngineBase::TOTAL_LIMBS;
+    int hidden = __builtin_popcount(letters);
+    uint32_t used = 0;
+    for (char c : order) {
+        uint32_t bit = 1u << (c - 'A');
+        if (c < 'A' || c > 'Z' || (used & bit)){
+            continue; //the queue skips letters it already used
+        }
+        used |= bit;
+        ++out.guesses;
+        bool hit = (letters & bit) != 0;
+        hidden -= hit;
+        if (hidden == 0) { //checked before the limb and guess limits
+            out.aiWon = true;
+            return out;
+        }
+        if (out.guesses >= GameEngineBase::MAX_GUESSES || limbs <= 0){
+            return out;
+        }
+        limbs -= hit; //player sacrifices after the turn
+    }
+    return out; //ai ran out of letters
+}
+
+OutcomeCache::OutcomeCache(const std::string& order, Layout layout)
+    : order_(order), layout_(layout)
+{
+    if (layout_ == Dense){
+        dense_.assign(size_t(1) << 26, 0);
+    }
+}
+
+GameOutcome OutcomeCache::outcome(uint32_t letters) {
+    letters &= (1u << 26) - 1;
+    if (layout_ == Dense) {
+        uint8_t& slot = dense_[letters];
+        if (slot) {
+            ++hits_;
+            GameOutcome o;
+            o.aiWon = (slot & 0x40) != 0;
+            o.guesses = slot & 0x3F;
+            return o;
+        }
+        ++misses_;
+        ++size_;
+        GameOutcome o = playFixedOrder(letters, order_);
+        slot = uint8_t(0x80 | (o.aiWon ? 0x40 : 0) | o.guesses); //guesses <= 26
+        return o;
+    }
+    auto it = sparse_.find(letters);
+    if (it != sparse_.end()) {
+        ++hits_;
+        return it->second;
+    }
+    ++misses_;
+    ++size_;
+    GameOutcome o = playFixedOrder(letters, order_);
+    sparse_.emplace(letters, o);
+    return o;
+}
+
+GameOutcome OutcomeCache::score(const std::string& phrase) {
+    return outcome(letterMask(phrase));
+}
+
+double OutcomeCache::hitRate() const {
+    uint64_t total = hits_ + misses_;
+    return total ? double(hits_) / double(total) : 0.0;
+}
@@ -0,0 +1,50 @@
+#ifndef OUTCOME_H
+#define OUTCOME_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//how a game ends when the ai plays a fixed letter order and the player gives up a limb on every hit
+struct GameOutcome {
+    bool aiWon = false;
+    int guesses = 0;
+};
+
+//bit c = letter 'A'+c appears, phrase already normalized
+uint32_t letterMask(const std::string& phrase);
+
+//same rules as GameEngineBase::playGuess, O(26): under a fixed order only the letter set matters
+//(which letters hit, in what turn), not the phrase length or how often a letter repeats
+GameOutcome playFixedOrder(uint32_t letters, const std::string& order);
+
+//game outcomes of one fixed order by letter set: repeated or near-identical phrases cost one lookup
+//sparse = hash map of the sets seen, dense = one byte for each of the 2^26 sets (64 MB, no hashing)
+//not thread safe, one cache per worker
+class OutcomeCache {
+public:
+    enum Layout { Sparse, Dense };
+
+    explicit OutcomeCache(const std::string& order, Layout layout = Sparse);
+
+    GameOutcome outcome(uint32_t letters); //cached, played on a miss
+    GameOutcome score(const std::string& phrase); //phrase already normalized
+
+    const std::string& order() const { return order_; }
+    size_t size() const { return size_; }
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+    double hitRate() const; //0..1
+
+private:
+    std::string order_;
+    Layout layout_;
+    std::unordered_map<uint32_t, GameOutcome> sparse_;
+    std::vector<uint8_t> dense_; //0 = unknown, else 0x80 | aiWon << 6 | guesses
+    size_t size_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+#endif // OUTCOME_H
@@ -0,0 +1,175 @@
+#include "phrasesolver.h"
+#include <array>
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+bool WordBigramModel::loadFromFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in){
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string prev, next;
+        uint32_t n = 1;
+        if (fields >> prev >> next) {
+            fields >> n;
+            add(prev, next, n);
+        }
+    }
+    return !pairs_.empty();
+}
+
+void WordBigramModel::add(const std::string& prev, const std::string& next, uint32_t count) {
+    std::string key = prev + ' ' + next;
+    for (char& c : key){
+        c = std::toupper((unsigned char)c);
+    }
+    pairs_[key] += count;
+}
+
+uint32_t WordBigramModel::count(const std::string& prev, const std::string& next) const {
+    auto it = pairs_.find(prev + ' ' + next);
+    return it == pairs_.end() ? 0 : it->second;
+}
+
+PhraseStrategy::PhraseStrategy(std::shared_ptr<const Dictionary> dict,
+                               std::shared_ptr<const WordBigramModel> bigrams)
+    : dict_(std::move(dict)), bigrams_(std::move(bigrams)), pool_(std::make_unique<WorkerPool>(defaultSolverThreads()))
+{
+}
+
+//add-one smoothed pair counts with the revealed neighbours
+double PhraseStrategy::weight(const Slot& slot, const std::string& word) const {
+    double w = 1.0;
+    if (!slot.prev.empty()){
+        w *= 1.0 + bigrams_->count(slot.prev, word);
+    }
+    if (!slot.next.empty()){
+        w *= 1.0 + bigrams_->count(word, slot.next);
+    }
+    return w;
+}
+
+void PhraseStrategy::scanLength(size_t len, std::vector<Slot*>& slots, uint32_t guessed,
+                                Clock::time_point deadline) {
+    const std::vector<std::string>& words = dict_->wordsOfLength(len);
+    const size_t CHUNK = 8192;
+    size_t chunks = (words.size() + CHUNK - 1) / CHUNK;
+    //per chunk: [slot][letter], index 26 = total
+    std::vector<std::vector<std::array<double, 27>>> part(chunks);
+
+    pool_->run(chunks, [&](size_t k) {
+        if (k > 0 && Clock::now() > deadline){
+            return; //out of time, chunks done so far are the sample
+        }
+        auto& acc = part[k];
+        acc.assign(slots.size(), std::array<double, 27>{});
+        size_t end = std::min(words.size(), (k + 1) * CHUNK);
+        for (size_t i = k * CHUNK; i < end; ++i) {
+            const std::string& w = words[i];
+            uint32_t letters = 0;
+            for (size_t s = 0; s < slots.size(); ++s) { //one read of the word serves every slot
+                if (!matchesPattern(w.data(), slots[s]->pattern.data(), len, guessed)){
+                    continue;
+                }
+                if (!letters) {
+                    for (char c : w){
+                        letters |= 1u << (c - 'A');
+                    }
+                }
+                double wt = weight(*slots[s], w);
+                acc[s][26] += wt;
+                for (uint32_t m = letters & ~guessed; m; m &= m - 1){
+                    acc[s][__builtin_ctz(m)] += wt;
+                }
+            }
+        }
+    });
+
+    for (const auto& acc : part) {
+        for (size_t s = 0; s < acc.size(); ++s) {
+            slots[s]->total += acc[s][26];
+            for (int c = 0; c < 26; ++c){
+                slots[s]->contains[c] += acc[s][c];
+            }
+        }
+    }
+}
+
+char PhraseStrategy::pick(const GuessState& state) {
+    if (!dict_){
+        return 0;
+    }
+    Clock::time_point deadline = std::min(Clock::now() + budget_, state.deadline); //own budget or caller's deadline
+    bool useBigrams = bigrams_ && !bigrams_->empty();
+
+    //collapse the phrase into distinct slots
+    auto words = splitWords(state.masked);
+    std::map<std::string, Slot> slots;
+    for (size_t k = 0; k < words.size(); ++k) {
+        std::string pattern = state.masked.substr(words[k].first, words[k].second);
+        if (pattern.find('_') == std::string::npos){
+            continue;
+        }
+        Slot s;
+        s.pattern = pattern;
+        if (useBigrams) {
+            auto known = [&](size_t j) {
+                std::string w = state.masked.substr(words[j].first, words[j].second);
+                return w.find('_') == std::string::npos ? w : std::string();
+            };
+            if (k > 0){
+                s.prev = known(k - 1);
+            }
+            if (k + 1 < words.size()){
+                s.next = known(k + 1);
+            }
+        }
+        std::string key = s.pattern + '|' + s.prev + '|' + s.next;
+        auto it = slots.find(key);
+        if (it == slots.end()){
+            it = slots.emplace(key, s).first;
+        }
+        ++it->second.copies;
+    }
+
+    //one dictionary pass per word length
+    std::map<size_t, std::vector<Slot*>> byLength;
+    for (auto& s : slots){
+        byLength[s.second.pattern.size()].push_back(&s.second);
+    }
+    for (auto& group : byLength){
+        scanLength(group.first, group.second, state.guessed, deadline);
+    }
+
+    //expected number of words each letter hits
+    double utility[26] = {};
+    bool any = false;
+    for (const auto& s : slots) {
+        const Slot& slot = s.second;
+        if (slot.total <= 0.0){
+            continue; //not in dictionary, no opinion
+        }
+        any = true;
+        for (int c = 0; c < 26; ++c){
+            utility[c] += slot.copies * slot.contains[c] / slot.total;
+        }
+    }
+    if (!any){
+        return 0;
+    }
+    int best = -1;
+    for (int c = 0; c < 26; ++c) {
+        if (state.guessed & (1u << c)){
+            continue;
+        }
+        if (utility[c] > 0.0 && (best < 0 || utility[c] > utility[best])){
+            best = c;
+        }
+    }
+    return best < 0 ? 0 : char('A' + best);
+}
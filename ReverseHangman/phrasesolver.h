@@ -0,0 +1,55 @@
+#ifndef PHRASESOLVER_H
+#define PHRASESOLVER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "solver.h"
+
+//counts of adjacent word pairs ("PREV NEXT" -> count), used to weight phrase candidates
+class WordBigramModel {
+public:
+    bool loadFromFile(const std::string& path); //lines "prev next count"
+    void add(const std::string& prev, const std::string& next, uint32_t count = 1);
+    uint32_t count(const std::string& prev, const std::string& next) const;
+    bool empty() const { return pairs_.empty(); }
+
+private:
+    std::unordered_map<std::string, uint32_t> pairs_; //key "PREV NEXT"
+};
+
+//scores letters over every unsolved word at once: utility = expected number of words hit
+//words of one length share a single dictionary pass, so long phrases cost one scan per length
+class PhraseStrategy final : public GuessStrategy {
+public:
+    explicit PhraseStrategy(std::shared_ptr<const Dictionary> dict,
+                            std::shared_ptr<const WordBigramModel> bigrams = nullptr);
+
+    void setTimeBudget(std::chrono::milliseconds budget) { budget_ = budget; }
+    void setThreadCount(unsigned n) { pool_ = std::make_unique<WorkerPool>(n ? n : 1); }
+
+    char pick(const GuessState& state) override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    //one distinct unsolved word (same pattern + same known neighbours = same slot)
+    struct Slot {
+        std::string pattern;
+        std::string prev, next; //fully revealed neighbours, empty if unknown/no bigram model
+        size_t copies = 0;      //how many words of the phrase share this slot
+        double total = 0.0;     //candidate weight
+        double contains[26] = {}; //candidate weight per letter
+    };
+
+    double weight(const Slot& slot, const std::string& word) const; //bigram weight of a candidate
+    void scanLength(size_t len, std::vector<Slot*>& slots, uint32_t guessed, Clock::time_point deadline);
+
+    std::shared_ptr<const Dictionary> dict_;
+    std::shared_ptr<const WordBigramModel> bigrams_;
+    std::chrono::milliseconds budget_{EntropyStrategy::DEFAULT_BUDGET_MS};
+    std::unique_ptr<WorkerPool> pool_; //started once, not per pick()
+};
+
+#endif // PHRASESOLVER_H
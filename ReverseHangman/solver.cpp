@@ -0,0 +1,354 @@
+#include "solver.h"
+#include "bitmapindex.h"
+#include "normalize.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+
+bool Dictionary::loadFromFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in){
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        addWord(line);
+    }
+    return count_ > 0;
+}
+
+void Dictionary::addWord(const std::string& word) {
+    bool utf8 = false;
+    for (char c : word) {
+        if ((unsigned char)c >= 0x80){
+            utf8 = true;
+        } else if (c != '\r' && c != '\n' && !std::isalpha((unsigned char)c)){
+            return; //skip words with digits, apostrophes etc.
+        }
+    }
+    std::string w;
+    if (utf8) {
+        w = normalizePhrase(word); //accented letters folded the way setSecret folds a secret (niño -> NINO)
+    } else {
+        for (char c : word) {
+            if (c != '\r' && c != '\n'){
+                w.push_back(std::toupper((unsigned char)c));
+            }
+        }
+    }
+    if (w.empty() || w.size() > 32){ //position masks are 32 bit
+        return;
+    }
+    if (!seen_.insert(w).second){
+        return; //case variant of a word we have
+    }
+    if (byLength_.size() <= w.size()){
+        byLength_.resize(w.size() + 1);
+    }
+    byLength_[w.size()].push_back(w);
+    ++count_;
+}
+
+//fnv-1a over the words sorted by (length, text), so load order doesn't matter
+uint64_t Dictionary::fingerprint() const {
+    uint64_t h = 1469598103934665603ull;
+    for (const auto& words : byLength_) {
+        std::vector<const std::string*> sorted;
+        sorted.reserve(words.size());
+        for (const std::string& w : words){
+            sorted.push_back(&w);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+        for (const std::string* w : sorted) {
+            for (char c : *w){
+                h = (h ^ (unsigned char)c) * 1099511628211ull;
+            }
+            h = (h ^ '\n') * 1099511628211ull; //word separator
+        }
+    }
+    return h;
+}
+
+const std::vector<std::string>& Dictionary::wordsOfLength(size_t len) const {
+    static const std::vector<std::string> none;
+    if (len >= byLength_.size()){
+        return none;
+    }
+    return byLength_[len];
+}
+
+std::vector<std::pair<size_t, size_t>> splitWords(const std::string& masked) {
+    std::vector<std::pair<size_t, size_t>> out;
+    size_t i = 0;
+    while (i < masked.size()) {
+        if (masked[i] == ' ') {
+            ++i;
+            continue;
+        }
+        size_t start = i;
+        while (i < masked.size() && masked[i] != ' '){
+            ++i;
+        }
+        out.push_back({start, i - start});
+    }
+    return out;
+}
+
+std::vector<std::string> unsolvedWords(const std::string& masked) {
+    std::vector<std::pair<size_t, std::string>> order; //(hidden count, pattern)
+    for (const auto& w : splitWords(masked)) {
+        std::string pattern = masked.substr(w.first, w.second);
+        size_t hidden = std::count(pattern.begin(), pattern.end(), '_');
+        if (hidden){
+            order.push_back({hidden, pattern});
+        }
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+    std::vector<std::string> out;
+    for (auto& o : order){
+        out.push_back(std::move(o.second));
+    }
+    return out;
+}
+
+bool matchesPattern(const char* word, const char* pattern, size_t len, uint32_t guessed) {
+    for (size_t i = 0; i < len; ++i) {
+        char p = pattern[i];
+        char w = word[i];
+        if (p == '_') {
+            if (guessed & (1u << (w - 'A'))){ //guessed letters are always revealed
+                return false;
+            }
+        } else if (p != w) {
+            return false;
+        }
+    }
+    return true;
+}
+
+WorkerPool::WorkerPool(unsigned threads) {
+    for (unsigned t = 1; t < threads; ++t){
+        helpers_.emplace_back([this] { loop(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& t : helpers_){
+        t.join();
+    }
+}
+
+void WorkerPool::work() {
+    for (size_t i = next_++; i < jobSize_; i = next_++){
+        (*job_)(i);
+    }
+}
+
+void WorkerPool::run(size_t n, const std::function<void(size_t)>& fn) {
+    if (helpers_.empty() || n <= 1) {
+        for (size_t i = 0; i < n; ++i){
+            fn(i);
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &fn;
+        jobSize_ = n;
+        next_ = 0;
+        busy_ = helpers_.size();
+        ++generation_;
+    }
+    wake_.notify_all();
+    work();
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return busy_ == 0; }); //fn must outlive every helper's use of it
+    job_ = nullptr;
+}
+
+void WorkerPool::loop() {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_){
+            return;
+        }
+        seen = generation_;
+        lock.unlock();
+        work();
+        lock.lock();
+        if (--busy_ == 0){
+            done_.notify_one();
+        }
+    }
+}
+
+EntropyStrategy::EntropyStrategy(std::shared_ptr<const Dictionary> dict)
+    : dict_(std::move(dict))
+{
+    pool_ = std::make_unique<WorkerPool>(defaultSolverThreads());
+    cache_ = std::make_shared<DecisionCache>();
+}
+
+bool EntropyStrategy::collectCandidates(const std::string& pattern, uint32_t guessed,
+                                        Clock::time_point deadline) {
+    survivors_.clear();
+    const std::vector<std::string>& words = dict_->wordsOfLength(pattern.size());
+    if (index_) { //bitmap ANDs instead of comparing every word, never needs a deadline
+        index_->candidates(pattern, guessed, candidateBits_);
+        BitmapIndex::forEachBit(candidateBits_, [&](size_t i) { survivors_.push_back(&words[i]); });
+        return true;
+    }
+    const size_t CHUNK = 8192;
+    size_t chunks = (words.size() + CHUNK - 1) / CHUNK;
+    std::vector<std::vector<const std::string*>> found(chunks);
+    std::atomic<bool> complete{true};
+
+    pool_->run(chunks, [&](size_t k) {
+        if (k > 0 && Clock::now() > deadline){ //out of time, keep what we have as a sample
+            complete = false;
+            return;
+        }
+        size_t end = std::min(words.size(), (k + 1) * CHUNK);
+        for (size_t i = k * CHUNK; i < end; ++i) {
+            if (matchesPattern(words[i].data(), pattern.data(), pattern.size(), guessed)){
+                found[k].push_back(&words[i]);
+            }
+        }
+    });
+    for (const auto& part : found){
+        survivors_.insert(survivors_.end(), part.begin(), part.end());
+    }
+    return complete;
+}
+
+double EntropyStrategy::scoreLetter(char c, size_t len, Clock::time_point deadline,
+                                    size_t& hits, bool& complete) const {
+    //group survivors by where c shows up in them (mask 0 = miss)
+    std::vector<uint32_t> masks;
+    size_t misses = 0;
+    size_t seen = 0;
+    for (const std::string* w : survivors_) {
+        if ((seen & 4095) == 0 && seen > 0 && Clock::now() > deadline){
+            break; //score the prefix we got through
+        }
+        ++seen;
+        uint32_t m = 0;
+        for (size_t i = 0; i < len; ++i) {
+            if ((*w)[i] == c){
+                m |= 1u << i;
+            }
+        }
+        if (m){
+            masks.push_back(m);
+        }
+        else{
+            ++misses;
+        }
+    }
+    hits = masks.size();
+    complete = seen == survivors_.size();
+    if (seen == 0){
+        return -1.0;
+    }
+
+    std::sort(masks.begin(), masks.end());
+    double n = double(seen);
+    double h = 0.0;
+    auto add = [&](size_t k) {
+        double p = double(k) / n;
+        h -= p * std::log2(p);
+    };
+    if (misses){
+        add(misses);
+    }
+    size_t run = 0;
+    for (size_t i = 0; i < masks.size(); ++i) {
+        ++run;
+        if (i + 1 == masks.size() || masks[i + 1] != masks[i]) {
+            add(run);
+            run = 0;
+        }
+    }
+    return h;
+}
+
+CachedDecision EntropyStrategy::solveWord(const std::string& pattern, uint32_t guessed,
+                                         Clock::time_point deadline, bool& complete) {
+    CachedDecision d;
+    complete = collectCandidates(pattern, guessed, deadline);
+    d.stats.total = survivors_.size();
+    if (survivors_.empty()){
+        return d;
+    }
+
+    //with the index the per-letter counts are popcounts, and letters in no candidate skip the walk
+    if (index_){
+        index_->countLetters(candidateBits_, pattern.size(), guessed, d.stats);
+    }
+    std::vector<char> letters;
+    for (int i = 0; i < 26; ++i) {
+        if (!(guessed & (1u << i)) && (!index_ || d.stats.contains[i] > 0)){
+            letters.push_back(char('A' + i));
+        }
+    }
+    std::vector<double> score(letters.size(), -1.0);
+    std::vector<size_t> hits(letters.size(), 0);
+    std::vector<char> done(letters.size(), 0);
+    pool_->run(letters.size(), [&](size_t i) {
+        bool full = false;
+        score[i] = scoreLetter(letters[i], pattern.size(), deadline, hits[i], full);
+        done[i] = full;
+    });
+
+    //best entropy, ties go to the letter found in the most candidates
+    int best = -1;
+    for (size_t i = 0; i < letters.size(); ++i) {
+        if (!index_){
+            d.stats.contains[letters[i] - 'A'] = hits[i];
+        }
+        complete = complete && done[i];
+        if (score[i] < 0.0 || hits[i] == 0){
+            continue;
+        }
+        if (best < 0 || score[i] > score[best] + 1e-12
+            || (std::fabs(score[i] - score[best]) <= 1e-12 && hits[i] > hits[best])){
+            best = (int)i;
+        }
+    }
+    if (best >= 0){
+        d.letter = letters[best];
+    }
+    return d;
+}
+
+char EntropyStrategy::pick(const GuessState& state) {
+    if (!dict_){
+        return 0;
+    }
+    Clock::time_point deadline = std::min(Clock::now() + budget_, state.deadline); //own budget or caller's deadline
+
+    for (const std::string& pattern : unsolvedWords(state.masked)) {
+        CachedDecision d;
+        if (!cache_ || !cache_->lookup(pattern, state.guessed, d)) { //seen state skips the scan
+            bool complete = false;
+            d = solveWord(pattern, state.guessed, deadline, complete);
+            if (cache_ && complete){ //never cache a decision made on a partial sample
+                cache_->store(pattern, state.guessed, d);
+            }
+        }
+        if (d.letter){
+            return d.letter;
+        }
+        //word not in dictionary, try the next one
+    }
+    return 0;
+}
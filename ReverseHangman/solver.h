@@ -0,0 +1,178 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "solvercache.h"
+
+//what the ai can see on its turn
+struct GuessState {
+    std::string masked; //maskedPhrase(), "_" for hidden letters
+    uint32_t guessed = 0; //bit i set once letter 'A'+i was tried
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max(); //answer by then
+};
+
+//per-turn solve times of the ai (quarter-octave histogram, so it stays small in batch runs)
+struct SolveStats {
+    static const int BUCKETS = 96; //1 us .. ~16 s
+
+    uint64_t turns = 0;
+    uint64_t deadlineHits = 0; //turns that ran past the deadline
+    uint64_t fallbacks = 0;    //turns answered from LetterQueue order
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+    uint64_t histogram[BUCKETS] = {}; //bucket i = solve times up to 2^(i/4) us
+
+    void record(double ms, bool late, bool fallback) {
+        ++turns;
+        deadlineHits += late;
+        fallbacks += fallback;
+        totalMs += ms;
+        maxMs = std::max(maxMs, ms);
+        double us = ms * 1000.0;
+        int b = us <= 1.0 ? 0 : int(std::ceil(4.0 * std::log2(us)));
+        ++histogram[std::min(b, BUCKETS - 1)];
+    }
+    double averageMs() const { return turns ? totalMs / double(turns) : 0.0; }
+    double percentileMs(double p) const { //upper edge of the bucket holding the p-th percentile (0..100)
+        uint64_t want = uint64_t(std::ceil(p / 100.0 * double(turns)));
+        uint64_t seen = 0;
+        for (int b = 0; b < BUCKETS && turns; ++b) {
+            seen += histogram[b];
+            if (seen >= want && seen > 0){
+                return std::min(maxMs, std::exp2(b / 4.0) / 1000.0);
+            }
+        }
+        return 0.0;
+    }
+};
+
+//letter picking strategy for the ai (returns 0 when it has no answer, engine then uses LetterQueue)
+class GuessStrategy {
+public:
+    virtual ~GuessStrategy() = default;
+    virtual char pick(const GuessState& state) = 0;
+};
+
+//asks primary first, secondary when primary has no answer
+class FallbackStrategy final : public GuessStrategy {
+public:
+    FallbackStrategy(std::unique_ptr<GuessStrategy> primary, std::unique_ptr<GuessStrategy> secondary)
+        : primary_(std::move(primary)), secondary_(std::move(secondary)) {}
+    char pick(const GuessState& state) override {
+        char c = primary_ ? primary_->pick(state) : 0;
+        return c ? c : (secondary_ ? secondary_->pick(state) : 0);
+    }
+
+private:
+    std::unique_ptr<GuessStrategy> primary_;
+    std::unique_ptr<GuessStrategy> secondary_;
+};
+
+//word list grouped by length (uppercase A-Z only)
+class Dictionary {
+public:
+    bool loadFromFile(const std::string& path); //one word per line, false if file missing/empty
+    void addWord(const std::string& word); //normalizes (utf-8 accents folded), drops words with non letters and repeats ("the"/"The")
+    const std::vector<std::string>& wordsOfLength(size_t len) const;
+    size_t size() const { return count_; }
+    uint64_t fingerprint() const; //hash of the sorted word list, tags files derived from this dictionary
+
+private:
+    std::vector<std::vector<std::string>> byLength_; //byLength_[n] = words with n letters
+    std::unordered_set<std::string> seen_; //normalized words already added, each counts once in the partitions
+    size_t count_ = 0;
+};
+
+//(start, length) of every word in a masked phrase
+std::vector<std::pair<size_t, size_t>> splitWords(const std::string& masked);
+
+//patterns of words that still have "_", most hidden letters first (the solver's focus order)
+std::vector<std::string> unsolvedWords(const std::string& masked);
+
+//true if word fits pattern ("_" = hidden) and hidden spots hold no letter already guessed
+bool matchesPattern(const char* word, const char* pattern, size_t len, uint32_t guessed);
+
+//worker count for solver scans (capped, 1 on single core builds)
+inline unsigned defaultSolverThreads() {
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw ? std::min(hw, 8u) : 1;
+}
+
+//runs fn(0..n-1) on threads started once and kept, for callers that fan out every turn
+//the calling thread works too, so a pool of n has n - 1 helpers; inline when only one
+class WorkerPool {
+public:
+    explicit WorkerPool(unsigned threads);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    unsigned threads() const { return unsigned(helpers_.size()) + 1; }
+    void run(size_t n, const std::function<void(size_t)>& fn); //fn(0..n-1), returns when all are done
+
+private:
+    void loop(); //helper thread body
+    void work(); //claims indices of the current job until none are left
+
+    std::vector<std::thread> helpers_;
+    std::mutex mutex_;
+    std::condition_variable wake_; //new job or stop
+    std::condition_variable done_; //last helper finished the job
+    const std::function<void(size_t)>* job_ = nullptr;
+    size_t jobSize_ = 0;
+    std::atomic<size_t> next_{0};
+    uint64_t generation_ = 0; //bumped per job so a helper runs each job once
+    size_t busy_ = 0; //helpers still on the current job
+    bool stop_ = false;
+};
+
+class BitmapIndex;
+
+//picks the letter with the largest expected reduction in candidate-set entropy
+//for the most hidden word of the phrase, letters are scored in parallel
+class EntropyStrategy final : public GuessStrategy {
+public:
+    static constexpr int DEFAULT_BUDGET_MS = 50;
+
+    explicit EntropyStrategy(std::shared_ptr<const Dictionary> dict);
+
+    void setTimeBudget(std::chrono::milliseconds budget) { budget_ = budget; }
+    void setThreadCount(unsigned n) { pool_ = std::make_unique<WorkerPool>(n ? n : 1); }
+    void setCache(std::shared_ptr<DecisionCache> cache) { cache_ = std::move(cache); } //share between engines, null = off
+    std::shared_ptr<DecisionCache> cache() const { return cache_; }
+    void setIndex(std::shared_ptr<const BitmapIndex> index) { index_ = std::move(index); } //built over the same dictionary, null = scan
+
+    char pick(const GuessState& state) override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    //collects words matching pattern into survivors_ (false if deadline cut it short)
+    bool collectCandidates(const std::string& pattern, uint32_t guessed, Clock::time_point deadline);
+    //entropy of the hit pattern of letter c over the survivors (-1 if nothing scored)
+    double scoreLetter(char c, size_t len, Clock::time_point deadline, size_t& hits, bool& complete) const;
+    //full search for one word, result only cacheable when complete
+    CachedDecision solveWord(const std::string& pattern, uint32_t guessed, Clock::time_point deadline, bool& complete);
+
+    std::shared_ptr<const Dictionary> dict_;
+    std::chrono::milliseconds budget_{DEFAULT_BUDGET_MS};
+    std::unique_ptr<WorkerPool> pool_; //started once, not per pick()
+    std::shared_ptr<DecisionCache> cache_;
+    std::shared_ptr<const BitmapIndex> index_;
+    std::vector<const std::string*> survivors_; //candidates of the focused word
+    std::vector<uint64_t> candidateBits_; //survivors_ as an index bitmap (index_ only)
+};
+
+#endif // SOLVER_H
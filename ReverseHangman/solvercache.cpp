@@ -0,0 +1,271 @@
+#include "solvercache.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+static const char STORE_MAGIC[4] = {'R', 'H', 'S', 'C'};
+
+//slot states, only ever move forward
+static const uint32_t SLOT_EMPTY = 0;
+static const uint32_t SLOT_WRITING = 1;
+static const uint32_t SLOT_READY = 2;
+
+struct DecisionStore::Header {
+    char magic[4];
+    uint32_t slots;
+    uint64_t tag;
+    uint32_t entries; //updated atomically
+    uint32_t reserved[3];
+};
+
+struct DecisionStore::Slot {
+    uint32_t state;   //updated atomically
+    uint32_t guessed;
+    uint8_t length;
+    char letter;
+    char pattern[DecisionStore::MAX_PATTERN];
+    char reserved[6];
+};
+
+bool DecisionStore::open(const std::string& path, uint64_t tag, uint32_t slots) {
+    static_assert(sizeof(Header) == 32 && sizeof(Slot) == 48, "store file layout");
+    hits_ = 0;
+    misses_ = 0;
+    if (slots == 0){
+        return false;
+    }
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (file_.openWritable(path, 0)) { //existing file, mapped as is
+            if (matches(tag)){
+                return true;
+            }
+            file_.close();
+        }
+        if (attempt > 0 || !create(path, tag, slots)){
+            return false; //another process put another dictionary's file there meanwhile, or no write access
+        }
+    }
+    return false;
+}
+
+bool DecisionStore::create(const std::string& path, uint64_t tag, uint32_t slots) {
+    std::string tmp = path + ".tmp" + std::to_string(std::random_device()()); //per process, never shared
+    {
+        MappedFile f;
+        if (!f.openWritable(tmp, sizeof(Header) + size_t(slots) * sizeof(Slot))){ //new file reads as zeros
+            return false;
+        }
+        Header* h = reinterpret_cast<Header*>(f.writableData());
+        h->slots = slots;
+        h->tag = tag;
+        std::memcpy(h->magic, STORE_MAGIC, 4);
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) { //atomic replace on posix
+        std::remove(path.c_str()); //windows rename won't overwrite, and fails while another process maps it
+        if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DecisionStore::matches(uint64_t tag) const {
+    if (file_.size() < sizeof(Header)){
+        return false;
+    }
+    const Header* h = header();
+    return std::memcmp(h->magic, STORE_MAGIC, 4) == 0 && h->tag == tag
+        && h->slots != 0 && file_.size() == sizeof(Header) + size_t(h->slots) * sizeof(Slot); //lookups do % slots
+}
+
+DecisionStore::Header* DecisionStore::header() const {
+    return reinterpret_cast<Header*>(const_cast<char*>(file_.data()));
+}
+
+DecisionStore::Slot* DecisionStore::slot(uint32_t i) const {
+    return reinterpret_cast<Slot*>(const_cast<char*>(file_.data()) + sizeof(Header)) + i;
+}
+
+//fnv-1a over pattern and mask
+uint64_t DecisionStore::hashKey(const std::string& pattern, uint32_t guessed) {
+    uint64_t h = 1469598103934665603ull;
+    for (char c : pattern){
+        h = (h ^ (unsigned char)c) * 1099511628211ull;
+    }
+    for (int i = 0; i < 4; ++i){
+        h = (h ^ ((guessed >> (8 * i)) & 0xFF)) * 1099511628211ull;
+    }
+    return h;
+}
+
+bool DecisionStore::lookup(const std::string& pattern, uint32_t guessed, char& letter) {
+    if (!isOpen() || pattern.size() > MAX_PATTERN){
+        return false;
+    }
+    uint32_t n = header()->slots;
+    uint32_t i = uint32_t(hashKey(pattern, guessed) % n);
+    for (uint32_t probe = 0; probe < n; ++probe, i = (i + 1) % n) {
+        Slot* s = slot(i);
+        uint32_t state = __atomic_load_n(&s->state, __ATOMIC_ACQUIRE);
+        if (state == SLOT_EMPTY){
+            break;
+        }
+        if (state == SLOT_READY && s->guessed == guessed && s->length == pattern.size()
+            && std::memcmp(s->pattern, pattern.data(), pattern.size()) == 0) {
+            letter = s->letter;
+            ++hits_;
+            return true;
+        }
+    }
+    ++misses_;
+    return false;
+}
+
+bool DecisionStore::append(const std::string& pattern, uint32_t guessed, char letter) {
+    if (!isOpen() || pattern.size() > MAX_PATTERN || letter == 0){ //word not in the dictionary, nothing to reuse
+        return false;
+    }
+    Header* h = header();
+    uint32_t n = h->slots;
+    if (__atomic_load_n(&h->entries, __ATOMIC_RELAXED) >= n - n / 4){
+        return false; //keep probes short, the file is warm enough
+    }
+    uint32_t i = uint32_t(hashKey(pattern, guessed) % n);
+    for (uint32_t probe = 0; probe < n; ++probe, i = (i + 1) % n) {
+        Slot* s = slot(i);
+        uint32_t expected = SLOT_EMPTY;
+        if (__atomic_compare_exchange_n(&s->state, &expected, SLOT_WRITING, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            s->guessed = guessed;
+            s->length = uint8_t(pattern.size());
+            s->letter = letter;
+            std::memcpy(s->pattern, pattern.data(), pattern.size());
+            __atomic_store_n(&s->state, SLOT_READY, __ATOMIC_RELEASE); //publish
+            __atomic_add_fetch(&h->entries, 1, __ATOMIC_RELAXED);
+            return true;
+        }
+        if (expected == SLOT_READY && s->guessed == guessed && s->length == pattern.size()
+            && std::memcmp(s->pattern, pattern.data(), pattern.size()) == 0){
+            return true; //already there (another engine or process got it first)
+        }
+    }
+    return false;
+}
+
+uint32_t DecisionStore::entries() const {
+    return isOpen() ? __atomic_load_n(&header()->entries, __ATOMIC_RELAXED) : 0;
+}
+
+uint32_t DecisionStore::slots() const {
+    return isOpen() ? header()->slots : 0;
+}
+
+double DecisionStore::hitRate() const {
+    uint64_t h = hits_, total = h + misses_;
+    return total ? double(h) / double(total) : 0.0;
+}
+
+DecisionCache::DecisionCache(size_t capacity)
+    : capacity_(capacity ? capacity : 1)
+{
+}
+
+//pattern plus the 4 mask bytes, patterns never hold '\0'
+std::string DecisionCache::makeKey(const std::string& pattern, uint32_t guessed) {
+    std::string key = pattern;
+    key.push_back('\0');
+    for (int i = 0; i < 4; ++i){
+        key.push_back(char((guessed >> (8 * i)) & 0xFF));
+    }
+    return key;
+}
+
+bool DecisionCache::lookup(const std::string& pattern, uint32_t guessed, CachedDecision& out) {
+    std::string key = makeKey(pattern, guessed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        char letter = 0;
+        if (!store_ || !store_->lookup(pattern, guessed, letter)){
+            ++misses_;
+            return false;
+        }
+        ++storeHits_;
+        //decided in an earlier run, only the letter is kept on disk
+        out = CachedDecision();
+        out.letter = letter;
+        out.hasStats = false;
+        if (lru_.size() >= capacity_) {
+            index_.erase(lru_.back().key);
+            lru_.pop_back();
+        }
+        lru_.push_front({key, out});
+        index_[key] = lru_.begin();
+        return true;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second); //move to front
+    out = it->second->value;
+    ++hits_;
+    return true;
+}
+
+void DecisionCache::store(const std::string& pattern, uint32_t guessed, const CachedDecision& d) {
+    std::string key = makeKey(pattern, guessed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (store_){
+        store_->append(pattern, guessed, d.letter);
+    }
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        it->second->value = d;
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return;
+    }
+    if (lru_.size() >= capacity_) { //evict least recently used
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+    }
+    lru_.push_front({key, d});
+    index_[key] = lru_.begin();
+}
+
+void DecisionCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+    hits_ = 0;
+    storeHits_ = 0;
+    misses_ = 0;
+}
+
+void DecisionCache::setStore(std::shared_ptr<DecisionStore> store) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    store_ = std::move(store);
+}
+
+size_t DecisionCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_.size();
+}
+
+uint64_t DecisionCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+uint64_t DecisionCache::storeHits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return storeHits_;
+}
+
+uint64_t DecisionCache::misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+double DecisionCache::hitRate() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t total = hits_ + storeHits_ + misses_;
+    return total ? double(hits_ + storeHits_) / double(total) : 0.0;
+}
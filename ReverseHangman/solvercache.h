@@ -0,0 +1,104 @@
+#ifndef SOLVERCACHE_H
+#define SOLVERCACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "mappedfile.h"
+
+//per-letter counts over the candidates of one masked word
+struct CandidateStats {
+    size_t total = 0; //candidates matching the pattern (0 = word not in dictionary)
+    std::array<size_t, 26> contains{}; //candidates containing each unguessed letter
+};
+
+//what the solver decided for one state
+struct CachedDecision {
+    char letter = 0;
+    CandidateStats stats; //empty when hasStats is false
+    bool hasStats = true; //false: restored from a DecisionStore, which keeps only the letter
+};
+
+//on-disk (pattern, guessed mask) -> letter table that survives restarts, shared by every process
+//open addressing in a memory-mapped file, entries are only ever added: a slot is claimed with a
+//compare-and-swap, filled, then published, so readers in other processes never see half a slot
+class DecisionStore {
+public:
+    static const uint32_t DEFAULT_SLOTS = 1 << 18;  //12 MB file
+    static const size_t MAX_PATTERN = 32;           //dictionary words are never longer
+
+    //tag identifies the dictionary (Dictionary::fingerprint()); a missing, corrupt or other-dictionary
+    //file is replaced by a fresh one built aside and renamed over it, never cleared in place, so a
+    //process still mapping the old file keeps a consistent (if orphaned) table
+    bool open(const std::string& path, uint64_t tag, uint32_t slots = DEFAULT_SLOTS);
+    void close() { file_.close(); }
+    bool isOpen() const { return file_.isOpen(); }
+
+    bool lookup(const std::string& pattern, uint32_t guessed, char& letter); //counts hit/miss
+    bool append(const std::string& pattern, uint32_t guessed, char letter);  //false if full, too long or no letter
+
+    uint32_t entries() const;
+    uint32_t slots() const;
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+    double hitRate() const; //0..1
+
+private:
+    struct Header;
+    struct Slot;
+    Header* header() const;
+    Slot* slot(uint32_t i) const;
+    bool matches(uint64_t tag) const; //mapped file is a store for this tag
+    static bool create(const std::string& path, uint64_t tag, uint32_t slots); //temp file + rename
+    static uint64_t hashKey(const std::string& pattern, uint32_t guessed);
+
+    MappedFile file_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+};
+
+//bounded LRU map (masked word pattern, guessed mask) -> decision, safe to share between engines/threads
+class DecisionCache {
+public:
+    static const size_t DEFAULT_CAPACITY = 1 << 16;
+
+    explicit DecisionCache(size_t capacity = DEFAULT_CAPACITY);
+
+    bool lookup(const std::string& pattern, uint32_t guessed, CachedDecision& out); //counts hit/store hit/miss
+    void store(const std::string& pattern, uint32_t guessed, const CachedDecision& d);
+    void clear();
+
+    //persistent second tier: misses fall through to it, stored decisions are appended to it;
+    //decisions found there carry only the letter (hasStats false)
+    void setStore(std::shared_ptr<DecisionStore> store);
+
+    size_t size() const;
+    size_t capacity() const { return capacity_; }
+    uint64_t hits() const;      //answered from memory
+    uint64_t storeHits() const; //answered from the store file
+    uint64_t misses() const;    //neither, the solver ran
+    double hitRate() const; //0..1, both kinds of hit
+
+private:
+    struct Entry {
+        std::string key;
+        CachedDecision value;
+    };
+    static std::string makeKey(const std::string& pattern, uint32_t guessed);
+
+    size_t capacity_;
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_; //front = most recently used
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    uint64_t hits_ = 0;
+    uint64_t storeHits_ = 0;
+    uint64_t misses_ = 0;
+    std::shared_ptr<DecisionStore> store_;
+};
+
+#endif // SOLVERCACHE_H
@@ -0,0 +1,63 @@
+#include "strategies.h"
+
+//plain frequency order, the engine's queue answers every turn
+class QueueOnlyStrategy final : public GuessStrategy {
+public:
+    char pick(const GuessState&) override { return 0; }
+};
+
+const std::vector<StrategyFactory>& registeredStrategies() {
+    static const std::vector<StrategyFactory> list = {
+        {"queue", "letter frequency order", [](const StrategyResources&) -> std::unique_ptr<GuessStrategy> {
+             return std::make_unique<QueueOnlyStrategy>();
+         }},
+        {"entropy", "dictionary entropy, one word at a time", [](const StrategyResources& res) -> std::unique_ptr<GuessStrategy> {
+             if (!res.dict){
+                 return nullptr;
+             }
+             auto ai = std::make_unique<EntropyStrategy>(res.dict);
+             ai->setIndex(res.index);
+             return ai;
+         }},
+        {"phrase", "joint expected hits over all words", [](const StrategyResources& res) -> std::unique_ptr<GuessStrategy> {
+             if (!res.dict){
+                 return nullptr;
+             }
+             return std::make_unique<PhraseStrategy>(res.dict, res.bigrams);
+         }},
+        {"dawg", "most candidates from the word graph", [](const StrategyResources& res) -> std::unique_ptr<GuessStrategy> {
+             if (!res.dawg){
+                 return nullptr;
+             }
+             return std::make_unique<DawgStrategy>(res.dawg);
+         }},
+        {"book", "opening book, then entropy", [](const StrategyResources& res) -> std::unique_ptr<GuessStrategy> {
+             if (!res.book || !res.dict){
+                 return nullptr;
+             }
+             return std::make_unique<OpeningBookStrategy>(res.book, std::make_unique<EntropyStrategy>(res.dict));
+         }},
+        {"tree", "offline decision tree, then entropy", [](const StrategyResources& res) -> std::unique_ptr<GuessStrategy> {
+             if (!res.tree || !res.dict){
+                 return nullptr;
+             }
+             return std::make_unique<DecisionTreeStrategy>(res.tree, std::make_unique<EntropyStrategy>(res.dict));
+         }},
+        {"ngram", "letter n-grams only (no dictionary)", [](const StrategyResources& res) -> std::unique_ptr<GuessStrategy> {
+             if (!res.ngram){
+                 return nullptr;
+             }
+             return std::make_unique<NGramStrategy>(res.ngram);
+         }},
+    };
+    return list;
+}
+
+std::unique_ptr<GuessStrategy> makeStrategy(const std::string& name, const StrategyResources& res) {
+    for (const StrategyFactory& f : registeredStrategies()) {
+        if (f.name == name){
+            return f.make(res);
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,39 @@
+#ifndef STRATEGIES_H
+#define STRATEGIES_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "bitmapindex.h"
+#include "dawg.h"
+#include "decisiontree.h"
+#include "ngrammodel.h"
+#include "openingbook.h"
+#include "phrasesolver.h"
+
+//shared data the strategies are built from, a strategy whose data is missing is not offered
+struct StrategyResources {
+    std::shared_ptr<const Dictionary> dict;
+    std::shared_ptr<const BitmapIndex> index; //over dict, optional
+    std::shared_ptr<const Dawg> dawg;
+    std::shared_ptr<const OpeningBook> book;
+    std::shared_ptr<const DecisionTree> tree;
+    std::shared_ptr<const NGramModel> ngram;
+    std::shared_ptr<const WordBigramModel> bigrams;
+};
+
+//named way to build one ai, null from make() = resources missing
+struct StrategyFactory {
+    std::string name;
+    std::string description;
+    std::function<std::unique_ptr<GuessStrategy>(const StrategyResources&)> make;
+};
+
+//every ai the engine ships, in a fixed order (benchmarks, tools, settings)
+const std::vector<StrategyFactory>& registeredStrategies();
+
+//build one registered strategy by name, null if unknown or its data is missing
+std::unique_ptr<GuessStrategy> makeStrategy(const std::string& name, const StrategyResources& res);
+
+#endif // STRATEGIES_H
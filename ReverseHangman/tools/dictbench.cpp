@@ -0,0 +1,94 @@
+#include "frontcoded.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+//memory vs scan speed of the word list layouts: std::vector<std::string> (what the solver scans)
+//and front coded blocks (frontcoded.h, built into this tool only)
+//usage: dictbench <words.txt>
+static double vectorBytes(const Dictionary& dict) {
+    double n = 0;
+    for (size_t len = 1; len <= 32; ++len) {
+        const auto& words = dict.wordsOfLength(len);
+        n += words.capacity() * sizeof(std::string);
+        for (const std::string& w : words){
+            n += w.capacity() > 15 ? w.capacity() + 1 : 0; //heap block past the small string buffer
+        }
+    }
+    return n;
+}
+
+static void countScan(const Dictionary& dict, const std::string& pattern, uint32_t guessed, CandidateStats& stats) {
+    stats = CandidateStats();
+    for (const std::string& w : dict.wordsOfLength(pattern.size())) {
+        if (!matchesPattern(w.data(), pattern.data(), pattern.size(), guessed)){
+            continue;
+        }
+        ++stats.total;
+        uint32_t letters = 0;
+        for (char c : w){
+            letters |= 1u << (c - 'A');
+        }
+        for (uint32_t m = letters & ~guessed; m; m &= m - 1){
+            ++stats.contains[__builtin_ctz(m)];
+        }
+    }
+}
+
+template <typename Fn>
+static double timeMs(int rounds, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r){
+        fn();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / rounds;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cerr << "usage: dictbench <words.txt>\n";
+        return 1;
+    }
+    Dictionary dict;
+    if (!dict.loadFromFile(argv[1])) {
+        std::cerr << "can't load word list " << argv[1] << "\n";
+        return 1;
+    }
+    //typical early-game states: nothing, one vowel, a few misses
+    const std::vector<std::pair<std::string, uint32_t>> probes = {
+        {"_____", 0}, {"__E____", 1u << 4}, {"________", (1u << 0) | (1u << 19)}, {"_A____", (1u << 0) | (1u << 4)},
+    };
+    const int ROUNDS = 20;
+
+    double base = 0;
+    for (const auto& p : probes) {
+        CandidateStats s;
+        base += timeMs(ROUNDS, [&] { countScan(dict, p.first, p.second, s); });
+    }
+    std::printf("%-16s %10s %12s\n", "layout", "KB", "scan ms");
+    std::printf("%-16s %10.0f %12.3f\n", "vector<string>", vectorBytes(dict) / 1024, base);
+
+    for (size_t block : {16, 32, 64}) {
+        FrontCodedDictionary fc;
+        fc.build(dict, block);
+        if (fc.size() != dict.size()) { //both sides must hold the same (deduped) word set
+            std::cerr << "front coded keeps " << fc.size() << " words, dictionary " << dict.size() << "\n";
+            return 1;
+        }
+        double ms = 0;
+        for (const auto& p : probes) {
+            CandidateStats s, check;
+            ms += timeMs(ROUNDS, [&] { fc.countLetters(p.first, p.second, s); });
+            countScan(dict, p.first, p.second, check);
+            if (s.total != check.total || s.contains != check.contains) {
+                std::cerr << "front coded counts differ on " << p.first << "\n";
+                return 1;
+            }
+        }
+        char name[32];
+        std::snprintf(name, sizeof(name), "front coded/%zu", block);
+        std::printf("%-16s %10.0f %12.3f\n", name, fc.memoryBytes() / 1024.0, ms);
+    }
+    return 0;
+}
@@ -0,0 +1,215 @@
+#include "mappedfile.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+//offline tool: corpus -> letter order for the ai queue (engine loadLetterOrder / order.txt),
+//optionally per-position and per-word-length letter tables
+//usage: letterprofile <corpus.txt> <order.txt> [--tables prefix] [--threads n]
+//the corpus is mapped and split across threads; the order comes from a byte histogram,
+//the tables from a word pass (spaces/newlines split words, other non-letters are dropped like normalize)
+
+static const int MAX_POS = 16; //positions 16+ share a row
+static const int MAX_LEN = 20; //lengths 20+ share a row
+
+struct Profile {
+    uint64_t bytes[256] = {};
+    uint64_t position[MAX_POS][26] = {};
+    uint64_t length[MAX_LEN + 1][26] = {};
+    uint64_t words = 0;
+};
+
+//4 striped tables so consecutive equal bytes don't wait on each other's increment
+static void byteHistogram(const unsigned char* p, size_t n, uint64_t out[256]) {
+    std::vector<uint32_t> stripes(4 * 256, 0);
+    uint32_t* h0 = stripes.data();
+    uint32_t* h1 = h0 + 256;
+    uint32_t* h2 = h1 + 256;
+    uint32_t* h3 = h2 + 256;
+    const size_t FLUSH = size_t(1) << 30; //keeps 32 bit counters from wrapping
+    for (size_t base = 0; base < n; base += FLUSH) {
+        size_t end = std::min(n, base + FLUSH);
+        size_t i = base;
+        for (; i + 8 <= end; i += 8) {
+            uint64_t w;
+            std::memcpy(&w, p + i, 8);
+            ++h0[w & 0xFF];
+            ++h1[(w >> 8) & 0xFF];
+            ++h2[(w >> 16) & 0xFF];
+            ++h3[(w >> 24) & 0xFF];
+            ++h0[(w >> 32) & 0xFF];
+            ++h1[(w >> 40) & 0xFF];
+            ++h2[(w >> 48) & 0xFF];
+            ++h3[w >> 56];
+        }
+        for (; i < end; ++i){
+            ++h0[p[i]];
+        }
+        for (int b = 0; b < 256; ++b) {
+            out[b] += uint64_t(h0[b]) + h1[b] + h2[b] + h3[b];
+            h0[b] = h1[b] = h2[b] = h3[b] = 0;
+        }
+    }
+}
+
+//letter index per byte, SEPARATOR for whitespace, SKIP for everything else
+static const uint8_t SEPARATOR = 26;
+static const uint8_t SKIP = 27;
+
+static void wordTables(const unsigned char* p, size_t n, const uint8_t* cls, Profile& prof) {
+    uint8_t word[64];
+    size_t len = 0, kept = 0;
+    auto flush = [&] {
+        if (len) {
+            int row = (int)std::min<size_t>(len, MAX_LEN);
+            for (size_t i = 0; i < kept; ++i){
+                ++prof.length[row][word[i]];
+            }
+            ++prof.words;
+        }
+        len = kept = 0;
+    };
+    for (size_t i = 0; i < n; ++i) {
+        uint8_t c = cls[p[i]];
+        if (c < 26) {
+            ++prof.position[std::min<size_t>(len, MAX_POS - 1)][c];
+            if (kept < sizeof(word)){
+                word[kept++] = c;
+            }
+            ++len;
+        } else if (c == SEPARATOR) {
+            flush();
+        }
+    }
+    flush();
+}
+
+static void writeTable(const std::string& path, const char* label, const uint64_t (*rows)[26], int count) {
+    std::ofstream out(path);
+    out << label;
+    for (int c = 0; c < 26; ++c){
+        out << ',' << char('A' + c);
+    }
+    out << '\n';
+    for (int r = 0; r < count; ++r) {
+        out << r;
+        for (int c = 0; c < 26; ++c){
+            out << ',' << rows[r][c];
+        }
+        out << '\n';
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        std::cerr << "usage: letterprofile <corpus.txt> <order.txt> [--tables prefix] [--threads n]\n";
+        return 1;
+    }
+    std::string tablePrefix;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--tables") == 0 && i + 1 < argc) {
+            tablePrefix = argv[++i];
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "unknown option " << argv[i] << "\n";
+            return 1;
+        }
+    }
+    MappedFile corpus;
+    if (!corpus.open(argv[1])) {
+        std::cerr << "can't open corpus " << argv[1] << "\n";
+        return 1;
+    }
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(corpus.data());
+    size_t size = corpus.size();
+
+    uint8_t cls[256];
+    for (int b = 0; b < 256; ++b) {
+        int u = b & 0xDF;
+        cls[b] = (b < 0x80 && u >= 'A' && u <= 'Z') ? uint8_t(u - 'A')
+               : (b == ' ' || b == '\n' || b == '\r' || b == '\t') ? SEPARATOR : SKIP;
+    }
+
+    //chunk edges moved to the next separator so no word is split
+    std::vector<size_t> edges{0};
+    for (unsigned t = 1; t < threads; ++t) {
+        size_t e = std::max(edges.back(), size * t / threads);
+        while (e < size && cls[data[e]] != SEPARATOR){
+            ++e;
+        }
+        edges.push_back(e);
+    }
+    edges.push_back(size);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Profile> parts(threads);
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            const unsigned char* p = data + edges[t];
+            size_t n = edges[t + 1] - edges[t];
+            byteHistogram(p, n, parts[t].bytes);
+            if (!tablePrefix.empty()){
+                wordTables(p, n, cls, parts[t]);
+            }
+        });
+    }
+    for (std::thread& th : pool){
+        th.join();
+    }
+    Profile total;
+    for (const Profile& part : parts) {
+        for (int b = 0; b < 256; ++b){
+            total.bytes[b] += part.bytes[b];
+        }
+        for (int r = 0; r < MAX_POS; ++r){
+            for (int c = 0; c < 26; ++c){
+                total.position[r][c] += part.position[r][c];
+            }
+        }
+        for (int r = 0; r <= MAX_LEN; ++r){
+            for (int c = 0; c < 26; ++c){
+                total.length[r][c] += part.length[r][c];
+            }
+        }
+        total.words += part.words;
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t letters[26];
+    for (int c = 0; c < 26; ++c){
+        letters[c] = total.bytes['A' + c] + total.bytes['a' + c];
+    }
+    std::string order = "ETAOINSHRDLUCMWFGYPBVKJXQZ"; //ties keep the classic order
+    std::stable_sort(order.begin(), order.end(), [&](char a, char b) {
+        return letters[a - 'A'] > letters[b - 'A'];
+    });
+    std::ofstream out(argv[2]);
+    out << order << '\n';
+    if (!out) {
+        std::cerr << "can't write " << argv[2] << "\n";
+        return 1;
+    }
+    if (!tablePrefix.empty()) {
+        writeTable(tablePrefix + ".position.csv", "position", total.position, MAX_POS);
+        writeTable(tablePrefix + ".length.csv", "length", total.length, MAX_LEN + 1);
+    }
+
+    std::cout << "order " << order << " -> " << argv[2] << "\n"
+              << size / 1e6 << " MB on " << threads << " threads in " << sec << " s ("
+              << (sec > 0 ? size / 1e9 / sec * 60.0 : 0.0) << " GB/min)";
+    if (!tablePrefix.empty()){
+        std::cout << ", " << total.words << " words profiled";
+    }
+    std::cout << "\n";
+    return 0;
+}
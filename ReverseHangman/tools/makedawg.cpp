@@ -0,0 +1,54 @@
+#include "dawg.h"
+#include "language.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+//offline tool: words.txt -> compact word graph for the memory-lean solver
+//usage: makedawg <words.txt> <words.dawg> [--pack packdir]
+//accented words are folded onto A-Z as the engine folds a secret: the pack's fold lines first
+//(--pack, e.g. for a language pack's own words.dawg), then the built-in latin table
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        std::cerr << "usage: makedawg <words.txt> <words.dawg> [--pack packdir]\n";
+        return 1;
+    }
+    std::string packPath;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--pack") == 0 && i + 1 < argc) {
+            packPath = argv[++i];
+        } else {
+            std::cerr << "unknown option " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+    Dictionary dict;
+    {
+        LanguagePack pack; //only its fold table, released before the graph is written (it may map the old one)
+        if (!packPath.empty() && !pack.load(packPath)) {
+            std::cerr << "can't load language pack " << packPath << "\n";
+            return 1;
+        }
+        std::ifstream in(argv[1]);
+        std::string line;
+        while (std::getline(in, line)) {
+            dict.addWord(packPath.empty() ? line : pack.fold(line));
+        }
+    }
+    if (dict.size() == 0) {
+        std::cerr << "can't load word list " << argv[1] << "\n";
+        return 1;
+    }
+
+    Dawg dawg;
+    dawg.build(dict);
+    if (!dawg.save(argv[2])) {
+        std::cerr << "can't write " << argv[2] << "\n";
+        return 1;
+    }
+    std::cout << "dawg: " << dict.size() << " words, " << dawg.nodeCount() << " nodes, "
+              << dawg.edgeCount() << " edges, " << dawg.memoryBytes() / 1024 << " KB -> " << argv[2] << "\n";
+    return 0;
+}
@@ -0,0 +1,27 @@
+#include "decisiontree.h"
+#include <iostream>
+
+//offline tool: words.txt -> guess tree file for GameEngine::loadDecisionTree
+//usage: makedecisiontree <words.txt> <tree.bin>
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        std::cerr << "usage: makedecisiontree <words.txt> <tree.bin>\n";
+        return 1;
+    }
+    Dictionary dict;
+    if (!dict.loadFromFile(argv[1])) {
+        std::cerr << "can't load word list " << argv[1] << "\n";
+        return 1;
+    }
+
+    DecisionTree tree;
+    tree.build(dict);
+    if (!tree.save(argv[2])) {
+        std::cerr << "can't write " << argv[2] << "\n";
+        return 1;
+    }
+    std::cout << "decision tree: " << dict.size() << " words, " << tree.nodeCount()
+              << " nodes -> " << argv[2] << "\n";
+    return 0;
+}
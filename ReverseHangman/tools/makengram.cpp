@@ -0,0 +1,24 @@
+#include "ngrammodel.h"
+#include <fstream>
+#include <iostream>
+
+//offline tool: phrase/word corpus -> quantized neighbour letter model
+//usage: makengram <corpus.txt> <ngram.bin>
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        std::cerr << "usage: makengram <corpus.txt> <ngram.bin>\n";
+        return 1;
+    }
+    std::ifstream corpus(argv[1]);
+    if (!corpus) {
+        std::cerr << "can't open corpus " << argv[1] << "\n";
+        return 1;
+    }
+    if (!NGramModel::build(corpus, argv[2])) {
+        std::cerr << "can't write " << argv[2] << "\n";
+        return 1;
+    }
+    std::cout << "n-gram model -> " << argv[2] << "\n";
+    return 0;
+}
@@ -0,0 +1,29 @@
+#include "openingbook.h"
+#include <cstdlib>
+#include <iostream>
+
+//build-time tool: words.txt -> opening book file for the ai
+//usage: makeopeningbook <words.txt> <openings.bin> [depth]
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        std::cerr << "usage: makeopeningbook <words.txt> <openings.bin> [depth]\n";
+        return 1;
+    }
+    Dictionary dict;
+    if (!dict.loadFromFile(argv[1])) {
+        std::cerr << "can't load word list " << argv[1] << "\n";
+        return 1;
+    }
+    int depth = argc > 3 ? std::atoi(argv[3]) : OpeningBook::DEFAULT_DEPTH;
+
+    OpeningBook book;
+    book.build(dict, depth);
+    if (!book.save(argv[2])) {
+        std::cerr << "can't write " << argv[2] << "\n";
+        return 1;
+    }
+    std::cout << "opening book: " << dict.size() << " words, depth " << book.depth()
+              << " -> " << argv[2] << "\n";
+    return 0;
+}
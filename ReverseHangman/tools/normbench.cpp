@@ -0,0 +1,89 @@
+#include "normalize.h"
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+//throughput of phrase normalization: the old per-character isalpha/toupper loop, normalizeAscii,
+//and the utf-8 folding normalizePhrase on ascii and mixed-script text
+//usage: normbench
+static std::string normalizeReference(const std::string& s) {
+    std::string r;
+    for (char c : s) {
+        if (std::isalpha((unsigned char)c) || c == ' '){
+            r.push_back(std::toupper((unsigned char)c));
+        }
+    }
+    return r;
+}
+
+template <typename Fn>
+static double megabytesPerSecond(const std::vector<std::string>& inputs, int rounds, Fn fn) {
+    size_t bytes = 0, sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const std::string& s : inputs) {
+            sink += fn(s).size();
+            bytes += s.size();
+        }
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (sink == 0){
+        std::printf("(empty output)\n");
+    }
+    return sec > 0 ? bytes / sec / 1e6 : 0.0;
+}
+
+static std::string asciiOnly(const std::string& s) {
+    std::string r(s.size(), '\0');
+    r.resize(normalizeAscii(s.data(), s.size(), &r[0]));
+    return r;
+}
+
+static std::string repeatTo(const std::string& sample, size_t bytes) {
+    std::string text;
+    while (text.size() < bytes){
+        text += sample;
+    }
+    return text;
+}
+
+int main()
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> start(0, 1000), len(12, 60);
+    const std::vector<std::pair<const char*, std::string>> scripts = {
+        {"ascii", "the quick brown fox, jumps over the lazy dog! it's 4 o'clock "},
+        {"latin accents", "Ærøskøbing café, naïve façade: Straße über Köln, señor Ñandú "},
+        {"mixed scripts", "Москва and Kyiv, 東京 to Zürich, Αθήνα vs Łódź, ＦＵＬＬ width "},
+    };
+    if (normalizePhrase("Crème Brûlée, Straße!") != "CREME BRULEE STRASSE") {
+        std::printf("utf-8 folding broken: %s\n", normalizePhrase("Crème Brûlée, Straße!").c_str());
+        return 1;
+    }
+
+    std::printf("%-16s %-22s %10s %10s %10s\n", "script", "input", "old MB/s", "ascii MB/s", "utf-8 MB/s");
+    for (const auto& script : scripts) {
+        std::string text = repeatTo(script.second, 4u << 20);
+        std::vector<std::string> phrases; //gui sized
+        for (int i = 0; i < 20000; ++i){
+            phrases.push_back(text.substr(start(rng), len(rng)));
+        }
+        std::vector<std::string> corpus{text}; //one multi-MB line
+        for (const std::string& s : phrases) {
+            if (asciiOnly(s) != normalizeReference(s)) {
+                std::printf("mismatch on \"%s\"\n", s.c_str());
+                return 1;
+            }
+        }
+        for (const auto& set : {std::make_pair("gui phrases (12-60 B)", &phrases), std::make_pair("corpus line (4 MB)", &corpus)}) {
+            std::printf("%-16s %-22s %10.0f %10.0f %10.0f\n", script.first, set.first,
+                        megabytesPerSecond(*set.second, 10, normalizeReference),
+                        megabytesPerSecond(*set.second, 10, asciiOnly),
+                        megabytesPerSecond(*set.second, 10, normalizePhrase));
+        }
+    }
+    return 0;
+}
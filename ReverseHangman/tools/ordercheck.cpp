@@ -0,0 +1,52 @@
+#include "gameengine.h"
+#include "lettermodel.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+//checks that a profiled order.txt reaches the guess queue the way the GUI sets the engine up:
+//order file loaded, then a (possibly empty) player history installed on top
+//usage: ordercheck [scratch.txt]   (exit 1 if any check failed)
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << (ok ? "ok   " : "FAIL ") << what << "\n";
+    failures += !ok;
+}
+
+//first ai guess of a fresh game on phrase
+static char firstGuess(GameEngine& engine, const std::string& phrase) {
+    engine.setSecret(phrase);
+    return engine.nextTurn().guess;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string path = argc > 1 ? argv[1] : "ordercheck.txt";
+    std::ofstream(path) << "ZQXJKVBPYGFWMUCLDRHSNIOATE\n"; //classic order reversed
+    const std::string PHRASE = "QUIZ";
+
+    GameEngine plain;
+    plain.setLetterModel(std::make_shared<LetterModel>());
+    check(firstGuess(plain, PHRASE) == 'E', "no order file: english first guess");
+
+    GameEngine gui;
+    check(gui.loadLetterOrder(path), "order file loads");
+    auto history = std::make_shared<LetterModel>(); //first run, nothing learned yet
+    gui.setLetterModel(history);
+    check(firstGuess(gui, PHRASE) == 'Z', "order file decides the first guess under an empty history");
+
+    LetterModel learned;
+    for (int i = 0; i < 100; ++i){
+        learned.observe("EEEEE");
+    }
+    std::string order = learned.order(gui.letterOrder());
+    check(order.size() == 26 && order[0] == 'E', "history moves a letter the player uses up");
+    check(order.substr(1, 3) == "ZQX", "letters without history keep the order file's ranking");
+    check(learned.order("AEI") == "EAI", "only the base order's letters are returned");
+
+    std::remove(path.c_str());
+    std::cout << (failures ? "ordercheck: FAILED\n" : "ordercheck: all passed\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,182 @@
+#include "gameengine.h"
+#include "normalize.h"
+#include "outcome.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+//offline tool: searches letter orders that win the most games against a phrase corpus
+//usage: orderopt <corpus.txt> <order.txt> [--start order.txt] [--iterations n] [--threads n]
+//phrases collapse into distinct letter sets with counts, one order costs O(distinct sets);
+//every thread climbs from its own start (swap / move-one-letter, sideways moves allowed)
+
+struct Bucket {
+    uint32_t letters;
+    uint64_t count;
+};
+
+//ai wins first, then fewer guesses in total
+static int64_t score(const std::vector<Bucket>& buckets, const std::string& order, uint64_t* wins = nullptr) {
+    uint64_t won = 0, guesses = 0;
+    for (const Bucket& b : buckets) {
+        GameOutcome o = playFixedOrder(b.letters, order);
+        won += o.aiWon * b.count;
+        guesses += uint64_t(o.guesses) * b.count;
+    }
+    if (wins){
+        *wins = won;
+    }
+    return int64_t(won << 32) - int64_t(guesses);
+}
+
+static std::string climb(const std::vector<Bucket>& buckets, std::string order, uint64_t iterations, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pos(0, 25);
+    int64_t current = score(buckets, order);
+    std::string best = order;
+    int64_t bestScore = current;
+    uint64_t stale = 0;
+    for (uint64_t it = 0; it < iterations; ++it) {
+        std::string next = order;
+        int a = pos(rng), b = pos(rng);
+        if (rng() & 1){
+            std::swap(next[a], next[b]);
+        }
+        else {
+            char c = next[a];
+            next.erase(a, 1);
+            next.insert(next.begin() + b, c);
+        }
+        int64_t s = score(buckets, next);
+        if (s >= current) {
+            stale = s > current ? 0 : stale + 1;
+            order.swap(next);
+            current = s;
+            if (s > bestScore) {
+                bestScore = s;
+                best = order;
+            }
+        } else if (++stale > 2000) { //stuck: restart from the best with a few random swaps
+            order = best;
+            for (int k = 0; k < 3; ++k){
+                std::swap(order[pos(rng)], order[pos(rng)]);
+            }
+            current = score(buckets, order);
+            stale = 0;
+        }
+    }
+    return best;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        std::cerr << "usage: orderopt <corpus.txt> <order.txt> [--start order.txt] [--iterations n] [--threads n]\n";
+        return 1;
+    }
+    std::string startPath;
+    uint64_t iterations = 20000;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--start") == 0 && i + 1 < argc) {
+            startPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "unknown option " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+    std::ifstream in(argv[1]);
+    if (!in) {
+        std::cerr << "can't open corpus " << argv[1] << "\n";
+        return 1;
+    }
+    std::unordered_map<uint32_t, uint64_t> sets;
+    std::vector<std::string> sample; //checked against the real engine
+    std::string line;
+    uint64_t phrases = 0;
+    while (std::getline(in, line)) {
+        if (line.empty()){
+            continue;
+        }
+        ++sets[letterMask(normalizePhrase(line))];
+        ++phrases;
+        if (sample.size() < 500){
+            sample.push_back(line);
+        }
+    }
+    std::vector<Bucket> buckets;
+    for (const auto& s : sets){
+        buckets.push_back({s.first, s.second});
+    }
+
+    BasicGameEngine<QueueStrategy> engine;
+    if (!startPath.empty() && !engine.loadLetterOrder(startPath)) {
+        std::cerr << "can't read start order " << startPath << "\n";
+        return 1;
+    }
+    std::string start = engine.letterOrder();
+
+    for (const std::string& phrase : sample) { //the shortcut must match the engine exactly
+        engine.setSecret(phrase);
+        while (!engine.isGameOver()) {
+            TurnInfo info = engine.nextTurn();
+            if (info.hit && !info.gameOver) {
+                auto limbs = engine.availableLimbs();
+                if (!limbs.empty()){
+                    engine.loseLimb(limbs.front().first);
+                }
+            }
+        }
+        GameOutcome o = playFixedOrder(letterMask(normalizePhrase(phrase)), start);
+        if (o.aiWon != !engine.playerWon() || o.guesses != engine.guessesUsed()) {
+            std::cerr << "letter-set shortcut disagrees with the engine on \"" << phrase << "\"\n";
+            return 1;
+        }
+    }
+
+    uint64_t baseWins = 0;
+    score(buckets, start, &baseWins);
+    std::vector<std::string> found(threads);
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            std::string from = start;
+            std::mt19937 rng(1000 + t);
+            if (t > 0){ //other threads start near, not at, the given order
+                std::shuffle(from.begin() + 6, from.end(), rng);
+            }
+            found[t] = climb(buckets, from, iterations, t + 1);
+        });
+    }
+    for (std::thread& th : pool){
+        th.join();
+    }
+    std::string best = start;
+    for (const std::string& o : found){
+        if (score(buckets, o) > score(buckets, best)){
+            best = o;
+        }
+    }
+    uint64_t bestWins = 0;
+    score(buckets, best, &bestWins);
+
+    std::ofstream out(argv[2]);
+    out << best << '\n';
+    if (!out) {
+        std::cerr << "can't write " << argv[2] << "\n";
+        return 1;
+    }
+    std::cout << phrases << " phrases in " << buckets.size() << " letter sets\n"
+              << "start " << start << ": ai wins " << baseWins << "\n"
+              << "best  " << best << ": ai wins " << bestWins << " -> " << argv[2] << "\n";
+    return 0;
+}
@@ -0,0 +1,313 @@
+#include "bitmapindex.h"
+#include "dawg.h"
+#include "dedupe.h"
+#include "gameengine.h"
+#include "normalize.h"
+#include "outcome.h"
+#include "phrasesolver.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iostream>
+
+//headless batch games: every corpus phrase against one ai, player always gives up the first limb left
+//usage: simulator <corpus.txt> [--words words.txt] [--strategy queue|entropy|phrase|dawg] [--adaptive [model.bin]] [--cache decisions.bin]
+//          [--lang packdir] [--index] [--order order.txt] [--outcomes [sparse|dense]] [--dedupe [MB]]
+//--dedupe drops phrases that repeat after normalization (and the --lang fold), bloom filter + exact set within MB (default 64)
+//--outcomes scores queue games by letter set from an outcome cache instead of playing them
+//--index answers entropy candidate scans from the letter-position bitmap index
+//--adaptive replays the corpus as a player history and compares the fixed queue order with the learned one
+
+struct BatchResult {
+    size_t games = 0;
+    size_t aiWins = 0;
+    size_t guesses = 0;
+    double seconds = 0.0;
+};
+
+//statically dispatched: one instantiation per strategy, no virtual call in the turn loop
+template <typename Engine>
+static BatchResult playAll(Engine& engine, const std::vector<std::string>& phrases,
+                           std::shared_ptr<const LanguagePack> language = nullptr, const std::string& orderPath = "") {
+    BatchResult r;
+    engine.setLanguage(language);
+    if (!orderPath.empty() && !engine.loadLetterOrder(orderPath)){
+        std::cerr << "can't read letter order " << orderPath << ", using the built-in one\n";
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string& phrase : phrases) {
+        engine.setNormalizedSecret(phrase); //normalized and folded on load
+        while (!engine.isGameOver()) {
+            TurnInfo info = engine.nextTurn();
+            if (info.hit && !info.gameOver) {
+                auto limbs = engine.availableLimbs();
+                if (!limbs.empty()){
+                    engine.loseLimb(limbs.front().first);
+                }
+            }
+        }
+        ++r.games;
+        r.aiWins += !engine.playerWon();
+        r.guesses += engine.guessesUsed();
+    }
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return r;
+}
+
+static const size_t INGEST_BATCH = 16384; //corpus lines read before a parallel normalize pass
+static const size_t INGEST_CHUNK = 1024;  //lines per worker task
+
+static void report(const std::string& name, const BatchResult& r) {
+    std::cout << name << ": " << r.games << " games, ai won " << r.aiWins
+              << " (" << (r.games ? 100.0 * r.aiWins / r.games : 0.0) << "%), "
+              << (r.games ? double(r.guesses) / r.games : 0.0) << " guesses/game, "
+              << (r.seconds > 0 ? r.games / r.seconds : 0.0) << " games/s\n";
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cerr << "usage: simulator <corpus.txt> [--words words.txt] [--strategy queue|entropy|phrase|dawg]"
+                     " [--adaptive [model.bin]] [--cache decisions.bin] [--lang packdir] [--index] [--order order.txt]"
+                     " [--outcomes [sparse|dense]] [--dedupe [MB]]\n";
+        return 1;
+    }
+    std::string wordsPath, modelPath;
+    std::string mode = "queue";
+    std::string cachePath, langPath, orderPath;
+    bool adaptive = false;
+    bool useIndex = false;
+    std::string outcomes; //empty = play every game
+    size_t dedupeBytes = 0; //0 = keep duplicates
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--words") == 0 && i + 1 < argc) {
+            wordsPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--strategy") == 0 && i + 1 < argc) {
+            mode = argv[++i];
+        } else if (std::strcmp(argv[i], "--order") == 0 && i + 1 < argc) {
+            orderPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--dedupe") == 0) {
+            dedupeBytes = PhraseDedupe::DEFAULT_MEMORY;
+            if (i + 1 < argc && argv[i + 1][0] != '-'){
+                dedupeBytes = std::max(1, std::atoi(argv[++i])) * (size_t(1) << 20);
+            }
+        } else if (std::strcmp(argv[i], "--outcomes") == 0) {
+            outcomes = "sparse";
+            if (i + 1 < argc && argv[i + 1][0] != '-'){
+                outcomes = argv[++i];
+            }
+        } else if (std::strcmp(argv[i], "--index") == 0) {
+            useIndex = true;
+        } else if (std::strcmp(argv[i], "--lang") == 0 && i + 1 < argc) {
+            langPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            cachePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--adaptive") == 0) {
+            adaptive = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-'){
+                modelPath = argv[++i];
+            }
+        } else {
+            std::cerr << "unknown option " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+    if (!outcomes.empty()) { //outcome cache replays the fixed queue order only
+        if (outcomes != "sparse" && outcomes != "dense") {
+            std::cerr << "unknown outcome cache layout " << outcomes << " (sparse or dense)\n";
+            return 1;
+        }
+        if (mode != "queue" || adaptive) {
+            std::cerr << "--outcomes only works with --strategy queue, not " << (adaptive ? "--adaptive" : mode) << "\n";
+            return 1;
+        }
+    }
+
+    std::ifstream in(argv[1]);
+    if (!in) {
+        std::cerr << "can't open corpus " << argv[1] << "\n";
+        return 1;
+    }
+    std::shared_ptr<const LanguagePack> language;
+    if (!langPath.empty()) {
+        auto pack = std::make_shared<LanguagePack>();
+        if (!pack->load(langPath)) {
+            std::cerr << "can't load language pack " << langPath << "\n";
+            return 1;
+        }
+        language = pack;
+    }
+
+    //lines are folded + normalized once here, as setSecret would, on every core a batch at a time;
+    //games then take them as is (setNormalizedSecret), dedupe keys on the same text
+    //double buffered: one batch is normalized, hashed and deduped (by shard) while the next is read
+    std::vector<std::string> phrases;
+    std::string line;
+    WorkerPool pool(defaultSolverThreads());
+    std::unique_ptr<ShardedPhraseDedupe> dedupe;
+    if (dedupeBytes){
+        dedupe = std::make_unique<ShardedPhraseDedupe>(dedupeBytes, pool.threads());
+    }
+    std::vector<std::string> batch, work; //being read, being processed
+    std::vector<std::string> keys; //work normalized
+    std::vector<uint64_t> hashes;
+    std::vector<char> keep;
+    auto process = [&]() {
+        keys.resize(work.size());
+        hashes.resize(work.size());
+        pool.run((work.size() + INGEST_CHUNK - 1) / INGEST_CHUNK, [&](size_t k) {
+            size_t end = std::min(work.size(), (k + 1) * INGEST_CHUNK);
+            for (size_t i = k * INGEST_CHUNK; i < end; ++i) {
+                keys[i] = normalizePhrase(language ? language->fold(work[i]) : work[i]);
+                if (dedupe){
+                    hashes[i] = PhraseDedupe::hash(keys[i]);
+                }
+            }
+        });
+        if (dedupe){
+            dedupe->insertBatch(keys, hashes, keep, pool);
+        }
+        for (size_t i = 0; i < work.size(); ++i) {
+            if (!dedupe || keep[i]){ //repeats are the same game as an earlier line
+                phrases.push_back(std::move(keys[i]));
+            }
+        }
+        work.clear();
+    };
+    std::future<void> pending; //process() of the previous batch, one in flight keeps phrases in order
+    auto flush = [&]() {
+        if (pending.valid()){
+            pending.get();
+        }
+        work.swap(batch);
+        if (pool.threads() > 1){
+            pending = std::async(std::launch::async, process);
+        }
+        else{
+            process(); //one core: nothing to overlap with, a second thread only costs switches
+        }
+    };
+    auto ingestStart = std::chrono::steady_clock::now();
+    size_t ingested = 0;
+    while (std::getline(in, line)) {
+        ingested += line.size() + 1;
+        if (line.empty()){
+            continue;
+        }
+        batch.push_back(std::move(line));
+        if (batch.size() == INGEST_BATCH){
+            flush();
+        }
+    }
+    flush();
+    if (pending.valid()){
+        pending.get();
+    }
+    double ingestSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - ingestStart).count();
+    std::cout << "ingest: " << ingested / 1e6 << " MB, " << phrases.size() << " phrases kept, "
+              << (ingestSec > 0 ? ingested / 1e6 / ingestSec : 0.0) << " MB/s\n";
+    if (dedupe) {
+        uint64_t seen = dedupe->seen();
+        std::cout << "dedupe: " << dedupe->duplicates() << " of " << seen << " phrases were repeats ("
+                  << (seen ? 100.0 * dedupe->duplicates() / seen : 0.0) << "% of games saved), "
+                  << dedupe->falsePositives() << " bloom false positives, " << dedupe->unconfirmed()
+                  << " unconfirmed, " << dedupe->memoryUsed() / 1024 << " KB\n";
+    }
+
+    if (adaptive) {
+        BasicGameEngine<QueueStrategy> fixed;
+        BatchResult before = playAll(fixed, phrases, language, orderPath);
+
+        BasicGameEngine<QueueStrategy> learner;
+        auto model = std::make_shared<LetterModel>();
+        if (!modelPath.empty()){
+            model->load(modelPath); //continue an earlier history
+        }
+        learner.setLetterModel(model);
+        BatchResult after = playAll(learner, phrases, language, orderPath); //learns on top of the same base order
+        if (!modelPath.empty()){
+            model->save(modelPath);
+        }
+
+        report("fixed order", before);
+        report("adaptive order", after);
+        double g0 = before.games ? double(before.guesses) / before.games : 0.0;
+        double g1 = after.games ? double(after.guesses) / after.games : 0.0;
+        std::cout << "adaptive ai: " << (long long)after.aiWins - (long long)before.aiWins << " more wins, "
+                  << g0 - g1 << " fewer guesses/game, final order "
+                  << model->order(language ? language->order() : learner.letterOrder()) << "\n";
+        return 0;
+    }
+
+    bool packWords = mode == "dawg" && language && language->dictionary();
+    auto dict = std::make_shared<Dictionary>();
+    if (mode != "queue" && !packWords && !dict->loadFromFile(wordsPath)) {
+        std::cerr << "strategy " << mode << " needs --words <word list>\n";
+        return 1;
+    }
+
+    BatchResult r;
+    if (mode == "queue" && !outcomes.empty()) {
+        BasicGameEngine<QueueStrategy> engine; //only for its queue order
+        if (!orderPath.empty()){
+            engine.loadLetterOrder(orderPath);
+        }
+        OutcomeCache cache(language ? language->order() : engine.letterOrder(),
+                           outcomes == "dense" ? OutcomeCache::Dense : OutcomeCache::Sparse);
+        auto start = std::chrono::steady_clock::now();
+        for (const std::string& phrase : phrases) {
+            GameOutcome o = cache.score(phrase); //normalized and folded on load
+            ++r.games;
+            r.aiWins += o.aiWon;
+            r.guesses += o.guesses;
+        }
+        r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "outcome cache (" << outcomes << "): " << cache.size() << " letter sets, "
+                  << cache.hits() << " hits, " << cache.misses() << " misses ("
+                  << cache.hitRate() * 100.0 << "%)\n";
+    } else if (mode == "queue") {
+        BasicGameEngine<QueueStrategy> engine;
+        r = playAll(engine, phrases, language, orderPath);
+    } else if (mode == "entropy") {
+        BasicGameEngine<EntropyStrategy> engine(dict);
+        if (useIndex) {
+            auto index = std::make_shared<BitmapIndex>();
+            index->build(*dict);
+            engine.strategy().setIndex(index);
+            std::cout << "bitmap index: " << index->memoryBytes() / 1024 << " KB\n";
+        }
+        auto store = std::make_shared<DecisionStore>();
+        if (!cachePath.empty() && store->open(cachePath, dict->fingerprint())){ //warm start from earlier runs
+            engine.strategy().cache()->setStore(store);
+        }
+        r = playAll(engine, phrases, language, orderPath);
+        const DecisionCache& cache = *engine.strategy().cache();
+        std::cout << "decision cache: " << cache.hits() << " memory hits, " << cache.storeHits() << " file hits, "
+                  << cache.misses() << " solved (" << cache.hitRate() * 100.0 << "% reused)\n";
+        if (store->isOpen()){
+            std::cout << "decision file: " << store->entries() << "/" << store->slots() << " entries, "
+                      << store->hits() << " hits, " << store->misses() << " misses ("
+                      << store->hitRate() * 100.0 << "%)\n";
+        }
+    } else if (mode == "phrase") {
+        BasicGameEngine<PhraseStrategy> engine(dict);
+        r = playAll(engine, phrases, language, orderPath);
+    } else if (mode == "dawg") {
+        std::shared_ptr<const Dawg> dawg = packWords ? language->dictionary() : nullptr;
+        if (!dawg) {
+            auto built = std::make_shared<Dawg>();
+            built->build(*dict);
+            dawg = built;
+        }
+        dict.reset(); //only the graph stays in memory
+        BasicGameEngine<DawgStrategy> engine(dawg);
+        r = playAll(engine, phrases, language, orderPath);
+    } else {
+        std::cerr << "unknown strategy " << mode << "\n";
+        return 1;
+    }
+    report(mode, r);
+    return 0;
+}
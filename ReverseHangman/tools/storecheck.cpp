@@ -0,0 +1,88 @@
+#include "solvercache.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+//checks DecisionStore against the files it can meet on disk: reopen, other dictionary, corrupt headers
+//usage: storecheck [scratch.bin]   (exit 1 on the first failed check)
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << (ok ? "ok   " : "FAIL ") << what << "\n";
+    failures += !ok;
+}
+
+//overwrites the header's slot count (offset 4, after the magic)
+static void patchSlots(const std::string& path, uint32_t slots) {
+    std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(4);
+    f.write(reinterpret_cast<const char*>(&slots), sizeof(slots));
+}
+
+static void truncateTo(const std::string& path, size_t bytes) {
+    std::string data(bytes, '\0');
+    std::ifstream(path, std::ios::binary).read(&data[0], (std::streamsize)bytes);
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(data.data(), (std::streamsize)bytes);
+}
+
+int main(int argc, char *argv[])
+{
+    std::string path = argc > 1 ? argv[1] : "storecheck.bin";
+    const uint32_t SLOTS = 64;
+    const uint64_t TAG = 0x1234, OTHER_TAG = 0x5678;
+    char letter = 0;
+    std::remove(path.c_str());
+
+    DecisionStore store;
+    check(!store.open(path, TAG, 0), "zero slots requested is refused");
+    check(store.open(path, TAG, SLOTS) && store.slots() == SLOTS && store.entries() == 0, "new file created");
+    check(store.append("C_T", 1u << 0, 'A'), "append");
+    check(store.lookup("C_T", 1u << 0, letter) && letter == 'A', "lookup after append");
+    store.close();
+
+    check(store.open(path, TAG, SLOTS) && store.entries() == 1, "reopen keeps entries");
+    check(store.lookup("C_T", 1u << 0, letter) && letter == 'A', "lookup after reopen");
+    check(!store.lookup("C_T", 1u << 1, letter), "other mask misses");
+
+    DecisionStore other;
+    check(other.open(path, OTHER_TAG, SLOTS) && other.entries() == 0, "other dictionary gets a fresh file");
+    check(!other.lookup("C_T", 1u << 0, letter), "other dictionary sees no old decisions");
+    check(store.lookup("C_T", 1u << 0, letter) && letter == 'A', "old holder's table untouched by the replace");
+    other.close();
+    store.close();
+
+    patchSlots(path, 0);
+    check(store.open(path, OTHER_TAG, SLOTS) && store.slots() == SLOTS && store.entries() == 0, "slots == 0 rebuilt");
+    check(!store.lookup("C_T", 0, letter), "lookup on rebuilt file");
+    store.close();
+
+    patchSlots(path, SLOTS * 2);
+    check(store.open(path, OTHER_TAG, SLOTS) && store.slots() == SLOTS, "slots past the file size rebuilt");
+    store.close();
+
+    patchSlots(path, SLOTS / 2);
+    check(store.open(path, OTHER_TAG, SLOTS) && store.slots() == SLOTS, "slots short of the file size rebuilt");
+    store.close();
+
+    truncateTo(path, 16);
+    check(store.open(path, OTHER_TAG, SLOTS) && store.slots() == SLOTS, "truncated header rebuilt");
+    check(store.append("DO_", 0, 'G') && store.lookup("DO_", 0, letter) && letter == 'G', "rebuilt file usable");
+    check(!store.append("XQZ_", 0, 0) && !store.lookup("XQZ_", 0, letter), "no-letter decision not written");
+    store.close();
+
+    auto warm = std::make_shared<DecisionStore>();
+    warm->open(path, OTHER_TAG, SLOTS);
+    DecisionCache cache;
+    cache.setStore(warm);
+    CachedDecision d;
+    check(cache.lookup("DO_", 0, d) && d.letter == 'G' && !d.hasStats, "store hit carries only the letter");
+    check(cache.lookup("DO_", 0, d) && !cache.lookup("CA_", 0, d), "memory hit, then a miss");
+    check(cache.storeHits() == 1 && cache.hits() == 1 && cache.misses() == 1, "store hits counted apart from misses");
+    warm->close();
+
+    std::remove(path.c_str());
+    std::cout << (failures ? "storecheck: FAILED\n" : "storecheck: all passed\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,187 @@
+#include "anytime.h"
+#include "gameengine.h"
+#include "strategies.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+//every registered strategy plays the same corpus, one after another
+//usage: tournament <corpus.txt> [--words words.txt] [--book openings.bin] [--tree tree.bin]
+//                  [--ngram ngram.bin] [--bigrams bigrams.txt] [--deadline ms] [--parallel] [--csv results.csv]
+//--deadline gives every turn that long behind an AnytimeStrategy (as the GUI does), "late" counts the
+//turns past it; no limit otherwise
+//--parallel plays one thread per strategy: quicker, but each solver's worker pool then competes with
+//the others for cores, so latencies measure that contention more than the strategy
+//--csv appends one dated row per strategy (track solver throughput over time)
+
+struct Standing {
+    std::string name;
+    bool played = false;
+    size_t games = 0;
+    size_t aiWins = 0;
+    size_t guesses = 0;
+    double seconds = 0.0;
+    SolveStats stats;
+};
+
+//player always gives up the first limb left, like the simulator
+static void playCorpus(Standing& s, std::unique_ptr<GuessStrategy> ai, const std::vector<std::string>& phrases,
+                       int deadlineMs) {
+    GameEngine engine;
+    engine.setStrategy(std::move(ai));
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string& phrase : phrases) {
+        engine.setSecret(phrase);
+        while (!engine.isGameOver()) {
+            auto deadline = deadlineMs > 0 ? std::chrono::steady_clock::now() + std::chrono::milliseconds(deadlineMs)
+                                           : std::chrono::steady_clock::time_point::max();
+            TurnInfo info = engine.nextTurn(deadline);
+            if (info.hit && !info.gameOver) {
+                auto limbs = engine.availableLimbs();
+                if (!limbs.empty()){
+                    engine.loseLimb(limbs.front().first);
+                }
+            }
+        }
+        ++s.games;
+        s.aiWins += !engine.playerWon();
+        s.guesses += engine.guessesUsed();
+    }
+    s.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    s.stats = engine.solveStats();
+    s.played = true;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cerr << "usage: tournament <corpus.txt> [--words words.txt] [--book openings.bin] [--tree tree.bin]"
+                     " [--ngram ngram.bin] [--bigrams bigrams.txt] [--deadline ms] [--parallel] [--csv results.csv]\n";
+        return 1;
+    }
+    StrategyResources res;
+    std::string csvPath;
+    bool parallel = false;
+    int deadlineMs = 0; //0 = no turn deadline
+    for (int i = 2; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--words") == 0 && hasValue) {
+            auto dict = std::make_shared<Dictionary>();
+            if (dict->loadFromFile(argv[++i])) {
+                auto dawg = std::make_shared<Dawg>();
+                dawg->build(*dict);
+                auto index = std::make_shared<BitmapIndex>();
+                index->build(*dict);
+                res.dict = dict;
+                res.dawg = dawg;
+                res.index = index;
+            }
+        } else if (std::strcmp(argv[i], "--book") == 0 && hasValue) {
+            auto book = std::make_shared<OpeningBook>();
+            if (book->load(argv[++i])){
+                res.book = book;
+            }
+        } else if (std::strcmp(argv[i], "--tree") == 0 && hasValue) {
+            auto tree = std::make_shared<DecisionTree>();
+            if (tree->load(argv[++i])){
+                res.tree = tree;
+            }
+        } else if (std::strcmp(argv[i], "--ngram") == 0 && hasValue) {
+            auto ngram = std::make_shared<NGramModel>();
+            if (ngram->load(argv[++i])){
+                res.ngram = ngram;
+            }
+        } else if (std::strcmp(argv[i], "--bigrams") == 0 && hasValue) {
+            auto bigrams = std::make_shared<WordBigramModel>();
+            if (bigrams->loadFromFile(argv[++i])){
+                res.bigrams = bigrams;
+            }
+        } else if (std::strcmp(argv[i], "--csv") == 0 && hasValue) {
+            csvPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--deadline") == 0 && hasValue) {
+            deadlineMs = std::atoi(argv[++i]);
+            if (deadlineMs <= 0) {
+                std::cerr << "--deadline needs a positive number of ms\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--parallel") == 0) {
+            parallel = true;
+        } else {
+            std::cerr << "unknown option " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+    std::ifstream in(argv[1]);
+    if (!in) {
+        std::cerr << "can't open corpus " << argv[1] << "\n";
+        return 1;
+    }
+    std::vector<std::string> phrases;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty()){
+            phrases.push_back(line);
+        }
+    }
+
+    const auto& factories = registeredStrategies();
+    std::vector<Standing> table(factories.size());
+    std::vector<std::thread> players;
+    for (size_t k = 0; k < factories.size(); ++k) {
+        table[k].name = factories[k].name;
+        std::unique_ptr<GuessStrategy> ai = factories[k].make(res);
+        if (!ai) {
+            std::cerr << "skipping " << factories[k].name << " (missing data)\n";
+            continue;
+        }
+        if (deadlineMs > 0){
+            ai = std::make_unique<AnytimeStrategy>(std::move(ai)); //answers by the deadline like the GUI's ai
+        }
+        if (parallel){
+            players.emplace_back(playCorpus, std::ref(table[k]), std::move(ai), std::cref(phrases), deadlineMs);
+        }
+        else{
+            playCorpus(table[k], std::move(ai), phrases, deadlineMs);
+        }
+    }
+    for (std::thread& t : players){
+        t.join();
+    }
+
+    std::cout << "strategy      win%  guesses/game    p50 ms    p90 ms    p99 ms    max ms  late  games/s\n";
+    std::ofstream csv;
+    if (!csvPath.empty()){
+        csv.open(csvPath, std::ios::app);
+    }
+    long long stamp = std::chrono::duration_cast<std::chrono::seconds>(
+                          std::chrono::system_clock::now().time_since_epoch()).count();
+    for (const Standing& s : table) {
+        if (!s.played){
+            continue;
+        }
+        double win = s.games ? 100.0 * s.aiWins / s.games : 0.0;
+        double avg = s.games ? double(s.guesses) / s.games : 0.0;
+        double rate = s.seconds > 0 ? s.games / s.seconds : 0.0;
+        char late[24] = "-"; //nothing can be late without a deadline
+        if (deadlineMs > 0){
+            std::snprintf(late, sizeof(late), "%llu", (unsigned long long)s.stats.deadlineHits);
+        }
+        char row[200];
+        std::snprintf(row, sizeof(row), "%-10s %7.1f %13.2f %9.3f %9.3f %9.3f %9.3f %5s %8.1f\n",
+                      s.name.c_str(), win, avg, s.stats.percentileMs(50), s.stats.percentileMs(90),
+                      s.stats.percentileMs(99), s.stats.maxMs, late, rate);
+        std::cout << row;
+        if (csv){
+            csv << stamp << ',' << s.name << ',' << s.games << ',' << win << ',' << avg << ','
+                << s.stats.percentileMs(50) << ',' << s.stats.percentileMs(90) << ','
+                << s.stats.percentileMs(99) << ',' << rate << '\n';
+        }
+    }
+    return 0;
+}